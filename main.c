@@ -31,21 +31,50 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "include/raylib.h"
 #include "include/raymath.h"
+#include "src/background.h"
+#include "src/court.h"
+#include "src/fontcache.h"
+#include "src/input.h"
+#include "src/inputcapture.h"
+#include "src/latency.h"
+#include "src/netplay.h"
+#include "src/particledraw.h"
+#include "src/particles.h"
+#include "src/profiler.h"
+#include "src/renderstats.h"
+#include "src/replay.h"
+#include "src/textcache.h"
+#include "src/rng.h"
+#include "src/sim.h"
+#include "src/timer.h"
+#include "src/trace.h"
+#include <limits.h>
 #include <math.h>
 #include <stdbool.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
-// Game constants
-#define SCREEN_WIDTH 1280
-#define SCREEN_HEIGHT 800
-#define PADDLE_WIDTH 25
-#define PADDLE_HEIGHT 200
-#define BALL_RADIUS 20
-#define BALL_INITIAL_SPEED 8.0f
-#define PADDLE_SPEED 12.0f
-#define MAX_BALL_SPEED 15.0f
-#define SPEED_INCREMENT 0.2f
-#define WALL_BOUNCE_BUFFER 2.0f  // Prevent ball from sticking to walls
+// Game constants (gameplay rules and physics live in src/sim.h)
+#define SCREEN_WIDTH SIM_COURT_WIDTH
+#define SCREEN_HEIGHT SIM_COURT_HEIGHT
+
+// Simulation timing - physics constants in src/sim.h are expressed per tick
+#define SIM_TICK_RATE 60
+#define SIM_DT (1.0f / SIM_TICK_RATE)
+#define SIM_TICK_NS (1000000000ULL / SIM_TICK_RATE)
+#define MAX_FRAME_TIME 0.25f     // Clamp long hitches so the sim doesn't spiral
+
+// Gamepad response curves (deadzone, saturation, exponent), overridden by
+// --stick-curve and --trigger-curve
+#define STICK_CURVE (InputCurve){ 0.12f, 0.95f, 1.5f }
+#define TRIGGER_CURVE (InputCurve){ 0.05f, 1.0f, 1.0f }
+
+// Cosmetic animation runs on wall-clock time. Effects first tuned per frame
+// at 60 FPS keep their look: speeds are scaled by COSMETIC_TUNED_FPS and
+// per-frame decay factors f become powf(f, dt * COSMETIC_TUNED_FPS).
+#define COSMETIC_TUNED_FPS 60.0f
+#define SHAKE_JITTER_RATE 60.0f  // New shake offsets per second, whatever the FPS
 
 #define COLOR_BACKGROUND        (Color){ 16, 24, 32, 255 }
 #define COLOR_ACCENT            (Color){ 65, 105, 225, 255 }
@@ -61,135 +90,341 @@ typedef enum {
     STATE_MODE_SELECT,
     STATE_PLAYING,
     STATE_PAUSED,
-    STATE_GAME_OVER
+    STATE_GAME_OVER,
+    STATE_CONNECTING    // Online: waiting for the other player
 } GameState;
 
 // Game modes
 typedef enum {
     MODE_AI,        // Player vs AI
-    MODE_MULTIPLAYER // Player vs Player
+    MODE_MULTIPLAYER, // Player vs Player
+    MODE_ONLINE     // Player vs Player over the network (--host / --join)
 } GameMode;
 
-// Ball structure
-typedef struct {
-    Vector2 position;
-    Vector2 velocity;
-    float radius;
-    Color color;
-} Ball;
-
-// Paddle structure
-typedef struct {
-    Rectangle rect;
-    float speed;
-    Color color;
-} Paddle;
-
-// Define a particle structure
-typedef struct {
-    Vector2 position;
-    Vector2 velocity;
-    float lifeTime;
-    float maxLifeTime;
-    Color color;
-    float size;
-} Particle;
-
-#define MAX_PARTICLES 100
+// Particle pool size; bursts are small but the engine handles far more
+#define MAX_PARTICLES 16384
 
 // Game structure
 typedef struct {
     GameState state;
     GameMode mode;
-    Ball ball;
-    Paddle playerPaddle; // First paddle (Player 1)
-    Paddle aiPaddle;  // Second paddle (AI or Player 2)
-    int playerScore;
-    int aiScore;
-    int winScore;
-    Font gameFont;         // Custom font for the game
+    SimState sim;          // Ball, paddles and scores (SIM_SIDE_LEFT is Player 1)
+    Color playerColor;     // First paddle (Player 1)
+    Color opponentColor;   // Second paddle (AI or Player 2)
+    uint64_t requestedSeed; // Fixed match seed from --seed, 0 for a fresh one each match
+    Rng cosmeticRng;       // Particles and shake; never affects gameplay
+    // Replays
+    const char *recordPath;  // --record: each match is written here
+    ReplayWriter *recorder;
+    ReplayReader playback;   // --replay: drives the sim instead of the keyboard
+    bool playingBack;
+    Netplay *net;            // Online match, NULL when playing locally
     Sound paddleHitSound;  // Sound for paddle hits
     Sound scoreSound;      // Sound for scoring
     bool fullscreen;       // Track fullscreen state
     float ballSpeedMultiplier; // Speed multiplier for ball (0.5 to 2.0)
+    SimAiTier aiTier;      // Difficulty of the AI opponent
+    InputSystem input;     // Keyboard, mouse and gamepad, per frame and per tick
     // Animation and effects
     float scoreAnimScale;    // For score change animation
     float lastScoreTime;     // Track when score last changed
     float screenShake;       // Screen shake effect amount
     Vector2 shakeOffset;     // Current screen shake offset
+    float shakeTimer;        // Time until the next shake offset is picked
     // Particle system
-    Particle particles[MAX_PARTICLES];
-    int activeParticles;
+    ParticleSystem particles;
+    // Fixed timestep
+    float accumulator;       // Unsimulated time carried between frames
+    float renderAlpha;       // Blend factor between previous and current tick
+    Vector2 prevBallPosition;
+    float prevPlayerPaddleY;
+    float prevAiPaddleY;
+    // F3 frame profiler overlay
+    Profiler profiler;
+    // F4 trace capture
+    const char *tracePath;
+    float traceSeconds;
+    // --benchmark: hidden window, frames drawn offscreen
+    bool benchmark;
+    RenderTexture2D offscreen;
+    // --latency: each frame tags where it drew the player's paddle and reads it back
+    bool measuringLatency;
+    int latencyMarker;
 } Game;
 
 // Function prototypes
 void InitGame(Game *game, GameMode mode);
 void UpdateGame(Game *game);
+void StepGame(Game *game);
 void DrawGame(Game *game);
-void ResetBall(Game *game, bool serverIsPlayer);
-bool CheckPaddleCollision(Ball *ball, Paddle *paddle, Game *game);
-void UpdateAI(Paddle *aiPaddle, Ball *ball, Game *game);
-void DrawSplashScreen(Font font);
+SimInput ReadPlayerInput(const Game *game);
+SimInput ScriptedInput(void);
+int8_t PaddleAxis(const InputState *input, int keyAxis, int gamepad);
+uint64_t TickInputEndNs(const Game *game);
+bool TicksRunning(const Game *game);
+Vector2 MousePosition(const Game *game);
+void HandleSimEvent(Game *game, const SimEvent *event);
+void ServeEffects(Game *game, bool serverIsPlayer);
+void UpdatePlaybackControls(Game *game);
+void UpdateOnline(Game *game);
+void LeaveOnline(Game *game);
+void DrawSplashScreen(void);
 void UpdateSplashScreen(Game *game);
-void DrawModeSelect(Font font, Game *game);
+void DrawModeSelect(Game *game);
 void UpdateModeSelect(Game *game);
+Rectangle AiDifficultyBounds(const Game *game);
 void CleanupGame(Game *game);
 void ToggleGameFullscreen(Game *game);
 void DrawRoundedRectangleWithGlow(Rectangle rec, float roundness, int segments, Color color);
 void DrawBallWithGlow(Vector2 center, float radius, Color color);
 void CreateParticleEffect(Game *game, Vector2 position, Color color, int count);
-void UpdateAndDrawParticles(Game *game);
+void UpdateParticles(Game *game);
+void ProfileDraws(Game *game, ProfileStage stage);
+void ToggleProfiler(Game *game);
+void DrawProfilerOverlay(Game *game);
+void ToggleTrace(Game *game);
+void RunGameFrame(Game *game);
+int RunBenchmark(Game *game, int frames, GameMode mode, const char *outPath);
+int RunLatency(Game *game, int trials, const char *outPath);
+Font UiFont(float fontSize);
+float FrameDeltaTime(void);
+float CosmeticDeltaTime(void);
+float CosmeticDecay(float perFrameFactor, float dt);
+
+// Every size the UI draws text at (ascending); each gets its own atlas
+static const int uiFontSizes[] = { 20, 24, 30, 40, 60, 70, 80, 100 };
+static FontSet uiFonts;
 
-int main(void) {
+// Benchmark runs advance every frame by exactly this much instead of the real frame time
+static float fixedFrameTime = 0.0f;
+
+int main(int argc, char **argv) {
+    // Options needed before the window opens: tracing (so --trace can capture
+    // startup and asset loads), the benchmark (hidden window, no audio) and
+    // the latency harness (no audio)
+    const char *tracePath = "pongtrace.json";
+    float traceSeconds = 5.0f;
+    bool traceAtLaunch = false;
+    int benchmarkFrames = 0;
+    GameMode benchmarkMode = MODE_AI;
+    const char *benchmarkOut = NULL;
+    int latencyTrials = 0;
+    const char *latencyOut = NULL;
+    for (int i = 1; i + 1 < argc; i++) {
+        if (strcmp(argv[i], "--trace") == 0) {
+            tracePath = argv[i + 1];
+            traceAtLaunch = true;
+        } else if (strcmp(argv[i], "--trace-seconds") == 0) {
+            traceSeconds = (float)atof(argv[i + 1]);
+        } else if (strcmp(argv[i], "--benchmark") == 0) {
+            benchmarkFrames = atoi(argv[i + 1]);
+        } else if (strcmp(argv[i], "--benchmark-mode") == 0) {
+            benchmarkMode = (strcmp(argv[i + 1], "multiplayer") == 0) ? MODE_MULTIPLAYER : MODE_AI;
+        } else if (strcmp(argv[i], "--benchmark-out") == 0) {
+            benchmarkOut = argv[i + 1];
+        } else if (strcmp(argv[i], "--latency") == 0) {
+            latencyTrials = atoi(argv[i + 1]);
+        } else if (strcmp(argv[i], "--latency-out") == 0) {
+            latencyOut = argv[i + 1];
+        }
+    }
+    bool unattended = benchmarkFrames > 0 || latencyTrials > 0;
+    if (unattended) {
+        // Keep raylib's info lines out of the results
+        SetTraceLogLevel(LOG_WARNING);
+    }
+    if (benchmarkFrames > 0) {
+        SetConfigFlags(FLAG_WINDOW_HIDDEN);
+    }
+    TraceNameThread("main");
+    if (traceAtLaunch && !TraceStart(tracePath, traceSeconds)) {
+        TraceLog(LOG_WARNING, "Could not write trace to %s", tracePath);
+    }
+    
     // Initialize window and audio
+    uint64_t traceStart = TraceZoneBegin();
     InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "Pong Game - By Bismaya");
-    InitAudioDevice();
+    if (!unattended) {
+        // Measurements run on machines without sound; unloaded sounds play as silence
+        InitAudioDevice();
+    }
     SetTargetFPS(60);
+    TraceZoneEnd("InitWindow", traceStart);
 
     // Load splash screen music
-    Music splashMusic = LoadMusicStream("assets/audio/Onyx - Ataraxia.mp3");
-    SetMusicVolume(splashMusic, 0.7f);
-    PlayMusicStream(splashMusic);
+    traceStart = TraceZoneBegin();
+    Music splashMusic = { 0 };
+    if (IsAudioDeviceReady()) {
+        splashMusic = LoadMusicStream("assets/audio/Onyx - Ataraxia.mp3");
+        SetMusicVolume(splashMusic, 0.7f);
+        PlayMusicStream(splashMusic);
+    }
+    TraceZoneEnd("LoadMusicStream", traceStart);
 
-    // Load custom font
-    Font gameFont = LoadFont("assets/fonts/Exo2-SemiBold.ttf");
-    if (gameFont.texture.id == 0) {
+    // Load custom font, baked once per UI size and cached next to the TTF
+    traceStart = TraceZoneBegin();
+    if (!FontSetLoad(&uiFonts, "assets/fonts/Exo2-SemiBold.ttf", "assets/fonts/Exo2-SemiBold.fontcache",
+                     uiFontSizes, sizeof(uiFontSizes) / sizeof(uiFontSizes[0]))) {
         // Fallback to default if custom font fails to load
-        gameFont = GetFontDefault();
+        TraceLog(LOG_WARNING, "Could not load the UI font, using the default font");
     }
+    TraceZoneEnd("FontSetLoad", traceStart);
 
     // Initialize game
     Game game = {0};  // Initialize all fields to zero/NULL
     game.state = STATE_SPLASH;
-    game.gameFont = gameFont;
     game.fullscreen = false;
     game.ballSpeedMultiplier = 1.0f; // Default speed multiplier
+    game.aiTier = SIM_AI_NORMAL;
+    game.tracePath = tracePath;
+    game.traceSeconds = traceSeconds;
+    game.benchmark = benchmarkFrames > 0;
+    if (!ParticleSystemInit(&game.particles, MAX_PARTICLES)) {
+        TraceLog(LOG_WARNING, "Could not allocate particles, effects disabled");
+    }
+    if (!InputCaptureInit(&game.input.queue)) {
+        TraceLog(LOG_WARNING, "Could not listen to window input");
+    }
+    InputCurve stickCurve = STICK_CURVE;
+    InputCurve triggerCurve = TRIGGER_CURVE;
+    
+    // Command line: frame cap, fixed seed, replay recording or playback, online play
+    const char *replayPath = NULL;
+    const char *joinAddress = NULL;
+    int hostPort = 0;
+    NetConditions netConditions = { 0, 0, 0 };
+    for (int i = 1; i + 1 < argc; i++) {
+        if (strcmp(argv[i], "--seed") == 0) {
+            game.requestedSeed = strtoull(argv[i + 1], NULL, 10);
+        } else if (strcmp(argv[i], "--fps") == 0) {
+            SetTargetFPS(atoi(argv[i + 1]));  // 0 runs uncapped
+        } else if (strcmp(argv[i], "--ai") == 0) {
+            if (!SimAiTierFromName(argv[i + 1], &game.aiTier)) TraceLog(LOG_WARNING, "Ignoring --ai %s (expected easy, normal, hard or expert)", argv[i + 1]);
+        } else if (strcmp(argv[i], "--record") == 0) {
+            game.recordPath = argv[i + 1];
+        } else if (strcmp(argv[i], "--replay") == 0) {
+            replayPath = argv[i + 1];
+        } else if (strcmp(argv[i], "--host") == 0) {
+            hostPort = atoi(argv[i + 1]);
+        } else if (strcmp(argv[i], "--join") == 0) {
+            joinAddress = argv[i + 1];
+        } else if (strcmp(argv[i], "--stick-curve") == 0) {
+            if (!InputCurveParse(argv[i + 1], &stickCurve)) {
+                TraceLog(LOG_WARNING, "Ignoring --stick-curve %s (expected deadzone,exponent[,saturation])", argv[i + 1]);
+            }
+        } else if (strcmp(argv[i], "--trigger-curve") == 0) {
+            if (!InputCurveParse(argv[i + 1], &triggerCurve)) {
+                TraceLog(LOG_WARNING, "Ignoring --trigger-curve %s (expected deadzone,exponent[,saturation])", argv[i + 1]);
+            }
+        } else if (strcmp(argv[i], "--netsim") == 0) {
+            if (!NetplayParseConditions(argv[i + 1], &netConditions)) {
+                TraceLog(LOG_WARNING, "Ignoring --netsim %s (expected latency,jitter,loss)", argv[i + 1]);
+            }
+        }
+    }
+    
+    for (int axis = GAMEPAD_AXIS_LEFT_X; axis <= GAMEPAD_AXIS_RIGHT_Y; axis++) game.input.curves[axis] = stickCurve;
+    game.input.curves[GAMEPAD_AXIS_LEFT_TRIGGER] = triggerCurve;
+    game.input.curves[GAMEPAD_AXIS_RIGHT_TRIGGER] = triggerCurve;
+    
+    // Online match: host on a port or join ADDRESS:PORT, then wait for the other side
+    if (hostPort > 0 || joinAddress != NULL) {
+        game.net = calloc(1, sizeof(Netplay));
+        bool opened = false;
+        if (game.net != NULL && hostPort > 0) {
+            uint64_t seed = game.requestedSeed ? game.requestedSeed : TimerNowNs();
+            opened = NetplayHost(game.net, hostPort, seed, game.ballSpeedMultiplier,
+                                 SIM_DEFAULT_WIN_SCORE, &netConditions);
+        } else if (game.net != NULL) {
+            char address[256];
+            const char *colon = strrchr(joinAddress, ':');
+            size_t length = (colon != NULL) ? (size_t)(colon - joinAddress) : 0;
+            if (colon != NULL && length < sizeof(address)) {
+                memcpy(address, joinAddress, length);
+                address[length] = '\0';
+                opened = NetplayJoin(game.net, address, atoi(colon + 1), &netConditions);
+            }
+        }
+        
+        if (opened) {
+            InitGame(&game, MODE_ONLINE);
+            game.state = STATE_CONNECTING;
+        } else {
+            TraceLog(LOG_ERROR, "Could not start online play");
+            free(game.net);
+            game.net = NULL;
+        }
+    }
+    
+    // Jump straight into the recorded match
+    if (replayPath != NULL) {
+        if (!ReplayReaderOpen(&game.playback, replayPath)) {
+            TraceLog(LOG_ERROR, "Could not read replay %s", replayPath);
+        } else {
+            game.playingBack = true;
+            game.ballSpeedMultiplier = game.playback.header.ballSpeedMultiplier;
+            InitGame(&game, game.playback.header.aiControlled[SIM_SIDE_RIGHT] ? MODE_AI : MODE_MULTIPLAYER);
+        }
+    }
     
     // Load sound effects
-    game.paddleHitSound = LoadSound("assets/audio/paddle_hit.mp3");
-    game.scoreSound = LoadSound("assets/audio/score.mp3");
+    traceStart = TraceZoneBegin();
+    if (IsAudioDeviceReady()) {
+        game.paddleHitSound = LoadSound("assets/audio/paddle_hit.mp3");
+        game.scoreSound = LoadSound("assets/audio/score.mp3");
+    }
+    TraceZoneEnd("LoadSound", traceStart);
+    
+    if (game.benchmark) {
+        int status = RunBenchmark(&game, benchmarkFrames, benchmarkMode, benchmarkOut);
+        CleanupGame(&game);
+        CloseWindow();
+        return status;
+    }
+    if (latencyTrials > 0) {
+        int status = RunLatency(&game, latencyTrials, latencyOut);
+        CleanupGame(&game);
+        CloseWindow();
+        return status;
+    }
 
     // Main game loop
     while (!WindowShouldClose()) {
+        ProfilerBeginFrame(&game.profiler);
+        ProfilerBegin(&game.profiler, PROFILE_MUSIC);
         UpdateMusicStream(splashMusic);
+        ProfilerEnd(&game.profiler, PROFILE_MUSIC);
+        
+        // Everything that happened since the last frame. Events past the
+        // last tick wait for the next frame's ticks, unless no ticks run.
+        InputCapturePoll();
+        InputBeginFrame(&game.input, TimerNowNs());
+        if (!TicksRunning(&game)) InputFlushTicks(&game.input);
 
         // Check for fullscreen toggle
-        if (IsKeyPressed(KEY_F)) {
+        if (InputKeyPressed(&game.input.frame, KEY_F)) {
             ToggleGameFullscreen(&game);
         }
+        if (InputKeyPressed(&game.input.frame, KEY_F3)) {
+            ToggleProfiler(&game);
+        }
+        if (InputKeyPressed(&game.input.frame, KEY_F4)) {
+            ToggleTrace(&game);
+        }
 
         switch (game.state) {
             case STATE_SPLASH:
                 UpdateSplashScreen(&game);
-                DrawSplashScreen(game.gameFont);
+                DrawSplashScreen();
                 break;
             case STATE_MODE_SELECT:
                 UpdateModeSelect(&game);
-                DrawModeSelect(game.gameFont, &game);
+                DrawModeSelect(&game);
                 break;
             default:
-                UpdateGame(&game);
-                DrawGame(&game);
+                RunGameFrame(&game);
+                // Only gameplay frames are profiled
+                ProfilerEndFrame(&game.profiler);
                 break;
         }
     }
@@ -203,7 +438,305 @@ int main(void) {
     return 0;
 }
 
+// Update, animate and draw one frame of a match
+void RunGameFrame(Game *game) {
+    uint64_t traceStart = TraceZoneBegin();
+    ProfilerBegin(&game->profiler, PROFILE_UPDATE);
+    UpdateGame(game);
+    ProfilerEnd(&game->profiler, PROFILE_UPDATE);
+    TraceZoneEnd("UpdateGame", traceStart);
+    
+    traceStart = TraceZoneBegin();
+    ProfilerBegin(&game->profiler, PROFILE_PARTICLES);
+    UpdateParticles(game);
+    ProfilerEnd(&game->profiler, PROFILE_PARTICLES);
+    TraceZoneEnd("UpdateParticles", traceStart);
+    
+    traceStart = TraceZoneBegin();
+    DrawGame(game);
+    TraceZoneEnd("DrawGame", traceStart);
+}
+
+static void PrintSummaryJson(FILE *out, const char *name, ProfileSummary summary, bool last) {
+    fprintf(out, "    \"%s\": { \"mean\": %.4f, \"p50\": %.4f, \"p95\": %.4f, \"p99\": %.4f, "
+            "\"max\": %.4f, \"drawCalls\": %d, \"vertices\": %d }%s\n",
+            name, summary.mean, summary.p50, summary.p95, summary.p99, summary.max,
+            summary.drawCalls, summary.vertices, last ? "" : ",");
+}
+
+// Play frames frames with no menus, no audio and no frame cap, drawing into
+// an offscreen texture, then write timings as JSON to outPath (stdout if NULL).
+// Input is the --replay file if one is playing, otherwise the built-in AI on
+// both paddles. Every frame advances exactly one sim tick, so runs on
+// different machines do the same work.
+int RunBenchmark(Game *game, int frames, GameMode mode, const char *outPath) {
+    SetTargetFPS(0);
+    fixedFrameTime = SIM_DT;
+    
+    game->offscreen = LoadRenderTexture(SCREEN_WIDTH, SCREEN_HEIGHT);
+    if (!IsRenderTextureValid(game->offscreen)) {
+        TraceLog(LOG_ERROR, "Could not create the offscreen render target");
+        return 1;
+    }
+    if (!RenderStatsInit()) {
+        TraceLog(LOG_WARNING, "Could not create the render stats batch, draw counts will read 0");
+    }
+    ProfilerSetEnabled(&game->profiler, true);
+    
+    // Scripted runs replay the same match every time unless --seed says otherwise
+    if (!game->playingBack) {
+        if (game->requestedSeed == 0) game->requestedSeed = 1;
+        InitGame(game, mode);
+    }
+    
+    // samples[stage * frames + frame], whole frame in the last stage row
+    ProfileSample *samples = malloc(sizeof(ProfileSample) * (size_t)frames * (PROFILE_STAGE_COUNT + 1));
+    if (samples == NULL) {
+        TraceLog(LOG_ERROR, "Out of memory for %d benchmark frames", frames);
+        return 1;
+    }
+    
+    int matches = 1;
+    uint64_t start = TimerNowNs();
+    for (int frame = 0; frame < frames; frame++) {
+        // Keep playing through finished matches and replays that ran out
+        if (game->state != STATE_PLAYING) {
+            InitGame(game, game->mode);
+            matches++;
+        }
+        
+        ProfilerBeginFrame(&game->profiler);
+        InputBeginFrame(&game->input, TimerNowNs());
+        RunGameFrame(game);
+        ProfilerEndFrame(&game->profiler);
+        for (int stage = 0; stage <= PROFILE_STAGE_COUNT; stage++) {
+            samples[stage * frames + frame] = ProfilerLastFrame(&game->profiler, stage);
+        }
+    }
+    double seconds = (double)(TimerNowNs() - start) / 1e9;
+    
+    FILE *out = (outPath != NULL) ? fopen(outPath, "w") : stdout;
+    if (out == NULL) {
+        TraceLog(LOG_ERROR, "Could not write %s", outPath);
+        free(samples);
+        return 1;
+    }
+    
+    fprintf(out, "{\n");
+    fprintf(out, "  \"frames\": %d,\n", frames);
+    fprintf(out, "  \"seconds\": %.4f,\n", seconds);
+    fprintf(out, "  \"fps\": %.1f,\n", frames / seconds);
+    fprintf(out, "  \"mode\": \"%s\",\n", (game->mode == MODE_AI) ? "ai" : "multiplayer");
+    fprintf(out, "  \"input\": \"%s\",\n", game->playingBack ? "replay" : "scripted");
+    fprintf(out, "  \"matches\": %d,\n", matches);
+    fprintf(out, "  \"width\": %d,\n", SCREEN_WIDTH);
+    fprintf(out, "  \"height\": %d,\n", SCREEN_HEIGHT);
+    fprintf(out, "  \"frameMs\": {\n");
+    PrintSummaryJson(out, "frame", ProfileSummarizeSamples(&samples[PROFILE_STAGE_COUNT * frames], frames), true);
+    fprintf(out, "  },\n");
+    fprintf(out, "  \"stageMs\": {\n");
+    for (int stage = 0; stage < PROFILE_STAGE_COUNT; stage++) {
+        PrintSummaryJson(out, ProfilerStageName(stage), ProfileSummarizeSamples(&samples[stage * frames], frames),
+                         stage == PROFILE_STAGE_COUNT - 1);
+    }
+    fprintf(out, "  }\n");
+    fprintf(out, "}\n");
+    
+    if (out != stdout) fclose(out);
+    free(samples);
+    return 0;
+}
+
+// Frame pacing and sim stepping combinations that --latency measures
+typedef struct {
+    bool vsync;
+    int fps;           // Frame cap, 0 for none
+    bool lockstep;     // One sim tick per frame instead of following the clock
+} LatencyConfig;
+
+static const LatencyConfig latencyConfigs[] = {
+    { false, 0, false }, { false, 60, false }, { false, 30, false },
+    { true, 0, false }, { true, 60, false }, { true, 30, false },
+    { false, 0, true }, { false, 60, true }, { false, 30, true },
+    { true, 0, true }, { true, 60, true }, { true, 30, true }
+};
+
+#define LATENCY_SETTLE_FRAMES 4                 // Paddle at rest this long before a press
+#define LATENCY_TIMEOUT_NS 1000000000ULL        // A press not seen by then is a miss
+#define LATENCY_MAX_FRAMES_PER_TRIAL 240        // Give up on a config that stops producing results
+
+static void PrintLatencyJson(FILE *out, const char *name, ProfileSummary summary, bool last) {
+    fprintf(out, "      \"%s\": { \"mean\": %.3f, \"p50\": %.3f, \"p95\": %.3f, \"p99\": %.3f, \"max\": %.3f }%s\n",
+            name, summary.mean, summary.p50, summary.p95, summary.p99, summary.max, last ? "" : ",");
+}
+
+// Measure input-to-present latency for every entry of latencyConfigs, trials
+// key presses each, and write the distributions as JSON to outPath (stdout if
+// NULL). A thread presses W or S at a random moment while the player's paddle
+// is at rest; the press goes through the input queue, UpdateGame and DrawGame
+// like a real one. Three times are kept per press: when the key went down,
+// when the frame whose tick first moved the paddle finished updating, and
+// when the swap returned for the first frame whose marker pixel shows the
+// paddle somewhere new. The frame cap is applied here, right after the swap
+// (where raylib would wait), so the swap can be timed on its own. Whatever
+// the display adds after the swap is not seen.
+int RunLatency(Game *game, int trials, const char *outPath) {
+    // The injector has to be the only thing feeding the input queue
+    InputCaptureShutdown();
+    InputReset(&game->input);
+    if (!LatencyInjectorStart(&game->input.queue)) {
+        TraceLog(LOG_ERROR, "Could not start the input injector");
+        return 1;
+    }
+    SetTargetFPS(0);
+    game->measuringLatency = true;
+    game->playingBack = false;  // Presses come from the injector, never a replay
+    if (game->requestedSeed == 0) game->requestedSeed = 1;
+    Rng rng;
+    RngSeed(&rng, game->requestedSeed, RNG_STREAM_LATENCY);
+    
+    // inputToSim, simToPresent and inputToPresent, trials each
+    ProfileSample *samples = malloc(sizeof(ProfileSample) * (size_t)trials * 3);
+    if (samples == NULL) {
+        TraceLog(LOG_ERROR, "Out of memory for %d latency trials", trials);
+        LatencyInjectorStop();
+        return 1;
+    }
+    FILE *out = (outPath != NULL) ? fopen(outPath, "w") : stdout;
+    if (out == NULL) {
+        TraceLog(LOG_ERROR, "Could not write %s", outPath);
+        free(samples);
+        LatencyInjectorStop();
+        return 1;
+    }
+    
+    fprintf(out, "{\n");
+    fprintf(out, "  \"trialsPerConfig\": %d,\n", trials);
+    fprintf(out, "  \"configs\": [\n");
+    
+    int status = 0;
+    int configCount = sizeof(latencyConfigs) / sizeof(latencyConfigs[0]);
+    for (int c = 0; c < configCount && !WindowShouldClose(); c++) {
+        const LatencyConfig *config = &latencyConfigs[c];
+        if (config->vsync) {
+            SetWindowState(FLAG_VSYNC_HINT);
+        } else {
+            ClearWindowState(FLAG_VSYNC_HINT);
+        }
+        fixedFrameTime = config->lockstep ? SIM_DT : 0.0f;
+        
+        ProfileSample *inputToSim = samples;
+        ProfileSample *simToPresent = samples + trials;
+        ProfileSample *inputToPresent = samples + 2 * trials;
+        int done = 0, missed = 0, aborted = 0, frames = 0;
+        
+        // Per press: settle, arm, wait for the press, the tick and the marker
+        int settled = 0, baseline = -1;
+        float baselineY = 0.0f;
+        bool armed = false;
+        uint64_t pressedNs = 0, simNs = 0;
+        uint64_t configStart = TimerNowNs();
+        uint64_t frameStart = configStart, frameNs = SIM_TICK_NS;
+        InitGame(game, MODE_AI);
+        game->sim.winScore = INT_MAX;  // Nobody wins mid-run
+        
+        while (done < trials && frames < trials * LATENCY_MAX_FRAMES_PER_TRIAL && !WindowShouldClose()) {
+            InputBeginFrame(&game->input, TimerNowNs());
+            UpdateGame(game);
+            float paddleY = game->sim.paddles[SIM_SIDE_LEFT].rect.y;
+            if (armed && pressedNs == 0) LatencyInjectorPressed(&pressedNs);
+            if (pressedNs != 0 && simNs == 0 && paddleY != baselineY) simNs = TimerNowNs();
+            UpdateParticles(game);
+            DrawGame(game);
+            uint64_t presentNs = TimerNowNs();
+            frames++;
+            
+            if (game->state != STATE_PLAYING) {
+                // Nobody can win, but start over if play ends anyway
+                if (armed) {
+                    LatencyInjectorRelease();
+                    armed = false;
+                    aborted++;
+                }
+                InitGame(game, MODE_AI);
+                game->sim.winScore = INT_MAX;
+                settled = 0;
+            } else if (!armed) {
+                // Wait until the last press has let go and the paddle is drawn at rest
+                settled = (game->latencyMarker == baseline) ? settled + 1 : 0;
+                baseline = game->latencyMarker;
+                if (settled >= LATENCY_SETTLE_FRAMES && baseline >= 0) {
+                    // Toward the middle, so the paddle never pins against a wall
+                    int key = (paddleY + SIM_PADDLE_HEIGHT / 2 > SCREEN_HEIGHT / 2) ? KEY_W : KEY_S;
+                    // Anywhere in the next two frames, so presses land at every phase of a frame
+                    uint64_t delay = (uint64_t)(RngFloat(&rng) * 2.0f * (float)frameNs);
+                    if (LatencyInjectorArm(key, presentNs + delay)) {
+                        armed = true;
+                        baselineY = paddleY;
+                        pressedNs = 0;
+                        simNs = 0;
+                    }
+                }
+            } else if (game->latencyMarker != baseline) {
+                if (pressedNs != 0 && simNs != 0) {
+                    inputToSim[done].ms = (float)((simNs - pressedNs) / 1e6);
+                    simToPresent[done].ms = (float)((presentNs - simNs) / 1e6);
+                    inputToPresent[done].ms = (float)((presentNs - pressedNs) / 1e6);
+                    done++;
+                } else {
+                    aborted++;  // Moved without the press (shouldn't happen)
+                }
+                LatencyInjectorRelease();
+                armed = false;
+                settled = 0;
+            } else if (pressedNs != 0 && presentNs - pressedNs > LATENCY_TIMEOUT_NS) {
+                missed++;
+                LatencyInjectorRelease();
+                armed = false;
+                settled = 0;
+            }
+            
+            // The frame cap, after the swap has been timed
+            if (config->fps > 0) {
+                double remaining = 1.0 / config->fps - (double)(TimerNowNs() - frameStart) / 1e9;
+                if (remaining > 0.0) WaitTime(remaining);
+            }
+            uint64_t now = TimerNowNs();
+            frameNs = now - frameStart;
+            frameStart = now;
+        }
+        if (armed) LatencyInjectorRelease();
+        if (done == 0) status = 1;
+        
+        fprintf(out, "%s    {\n", (c > 0) ? ",\n" : "");
+        fprintf(out, "      \"vsync\": %s,\n", config->vsync ? "true" : "false");
+        fprintf(out, "      \"fps\": %d,\n", config->fps);
+        fprintf(out, "      \"step\": \"%s\",\n", config->lockstep ? "lockstep" : "realtime");
+        fprintf(out, "      \"trials\": %d,\n", done);
+        fprintf(out, "      \"missed\": %d,\n", missed);
+        fprintf(out, "      \"aborted\": %d,\n", aborted);
+        fprintf(out, "      \"frameMs\": %.3f,\n", frames ? (double)(TimerNowNs() - configStart) / 1e6 / frames : 0.0);
+        PrintLatencyJson(out, "inputToSimMs", ProfileSummarizeSamples(inputToSim, done), false);
+        PrintLatencyJson(out, "simToPresentMs", ProfileSummarizeSamples(simToPresent, done), false);
+        PrintLatencyJson(out, "inputToPresentMs", ProfileSummarizeSamples(inputToPresent, done), true);
+        fprintf(out, "    }");
+    }
+    fprintf(out, "\n  ]\n");
+    fprintf(out, "}\n");
+    
+    ClearWindowState(FLAG_VSYNC_HINT);
+    fixedFrameTime = 0.0f;
+    game->measuringLatency = false;
+    LatencyInjectorStop();
+    if (out != stdout) fclose(out);
+    free(samples);
+    return status;
+}
+
 void ToggleGameFullscreen(Game *game) {
+    // The cached court layer is sized for the old resolution
+    CourtInvalidate();
+    
     if (!game->fullscreen) {
         // Save current window size before going to fullscreen
         SetWindowState(FLAG_FULLSCREEN_MODE);
@@ -216,33 +749,41 @@ void ToggleGameFullscreen(Game *game) {
 }
 
 void CleanupGame(Game *game) {
+    // Finish any replay still being written
+    ReplayWriterClose(game->recorder);
+    game->recorder = NULL;
+    ReplayReaderClose(&game->playback);
+    LeaveOnline(game);
+    
     // Unload resources to prevent memory leaks
-    UnloadFont(game->gameFont);
+    TextCacheClear();
+    BackgroundUnload();
+    CourtUnload();
+    ParticleDrawUnload();
+    RenderStatsUnload();
+    InputCaptureShutdown();
+    if (game->offscreen.id != 0) UnloadRenderTexture(game->offscreen);
+    FontSetUnload(&uiFonts);
+    TraceShutdown();  // Finishes the trace file if a capture is still running
+    ParticleSystemFree(&game->particles);
     UnloadSound(game->paddleHitSound);
     UnloadSound(game->scoreSound);
 }
 
-void DrawSplashScreen(Font font) {
+void DrawSplashScreen(void) {
     BeginDrawing();
     
     // Modern gradient background
     Color topColor = (Color){ 12, 20, 28, 255 };
     Color bottomColor = COLOR_BACKGROUND;
     
-    for (int y = 0; y < SCREEN_HEIGHT; y++) {
-        float factor = (float)y / SCREEN_HEIGHT;
-        Color lineColor = {
-            (unsigned char)Lerp(topColor.r, bottomColor.r, factor),
-            (unsigned char)Lerp(topColor.g, bottomColor.g, factor),
-            (unsigned char)Lerp(topColor.b, bottomColor.b, factor),
-            255
-        };
-        DrawLine(0, y, SCREEN_WIDTH, y, lineColor);
-    }
+    BackgroundDraw(topColor, bottomColor, SCREEN_WIDTH, SCREEN_HEIGHT);
 
+    float dt = CosmeticDeltaTime();
+    
     // Draw animated particles
     static float particleTime = 0;
-    particleTime += GetFrameTime();
+    particleTime += dt;
     
     // Draw particles
     for (int i = 0; i < 100; i++) {
@@ -252,20 +793,23 @@ void DrawSplashScreen(Font font) {
         float y = cosf(particleTime * 0.37f + i * 1.153f) * SCREEN_HEIGHT * 0.5f + SCREEN_HEIGHT * 0.5f;
         float alpha = (sinf(particleTime + i) * 0.5f + 0.5f) * 0.5f;
         
-        DrawCircle(x, y, size, ColorAlpha(COLOR_ACCENT, alpha));
+        ParticleDrawDot((Vector2){ x, y }, size, ColorAlpha(COLOR_ACCENT, alpha));
     }
     
     // Draw animated pong elements in background
     static float ballPosX = 300;
     static float ballPosY = 400;
-    static float ballVelX = 3;
-    static float ballVelY = 2;
+    static float ballVelX = 3 * COSMETIC_TUNED_FPS;   // Pixels per second
+    static float ballVelY = 2 * COSMETIC_TUNED_FPS;
     
-    ballPosX += ballVelX;
-    ballPosY += ballVelY;
+    ballPosX += ballVelX * dt;
+    ballPosY += ballVelY * dt;
     
-    if (ballPosX < 50 || ballPosX > SCREEN_WIDTH - 50) ballVelX *= -1;
-    if (ballPosY < 50 || ballPosY > SCREEN_HEIGHT - 50) ballVelY *= -1;
+    // Bounce by side rather than flipping, so a long frame can't trap the ball outside
+    if (ballPosX < 50) ballVelX = fabsf(ballVelX);
+    if (ballPosX > SCREEN_WIDTH - 50) ballVelX = -fabsf(ballVelX);
+    if (ballPosY < 50) ballVelY = fabsf(ballVelY);
+    if (ballPosY > SCREEN_HEIGHT - 50) ballVelY = -fabsf(ballVelY);
     
     // Enhanced glow effects for background elements
     float glowSize = sinf(GetTime() * 2) * 5 + 15;
@@ -297,15 +841,15 @@ void DrawSplashScreen(Font font) {
     titleOffset = sinf(GetTime() * 1.5f) * 8.0f;
     
     Vector2 titlePos = {
-        SCREEN_WIDTH / 2 - MeasureTextEx(font, title, titleFontSize, 1).x / 2,
+        SCREEN_WIDTH / 2 - TextCacheMeasure(UiFont(titleFontSize), title, titleFontSize, 1).x / 2,
         SCREEN_HEIGHT / 2 - 120 + titleOffset
     };
     
     // Enhanced glow effect with multiple layers
-    DrawTextEx(font, title, (Vector2){titlePos.x + 6, titlePos.y + 6}, titleFontSize, 1, ColorAlpha(COLOR_ACCENT, 0.2f));
-    DrawTextEx(font, title, (Vector2){titlePos.x + 4, titlePos.y + 4}, titleFontSize, 1, ColorAlpha(COLOR_ACCENT, 0.4f));
-    DrawTextEx(font, title, (Vector2){titlePos.x + 2, titlePos.y + 2}, titleFontSize, 1, ColorAlpha(COLOR_ACCENT, 0.6f));
-    DrawTextEx(font, title, titlePos, titleFontSize, 1, WHITE);
+    TextCacheDraw(UiFont(titleFontSize), title, (Vector2){titlePos.x + 6, titlePos.y + 6}, titleFontSize, 1, ColorAlpha(COLOR_ACCENT, 0.2f));
+    TextCacheDraw(UiFont(titleFontSize), title, (Vector2){titlePos.x + 4, titlePos.y + 4}, titleFontSize, 1, ColorAlpha(COLOR_ACCENT, 0.4f));
+    TextCacheDraw(UiFont(titleFontSize), title, (Vector2){titlePos.x + 2, titlePos.y + 2}, titleFontSize, 1, ColorAlpha(COLOR_ACCENT, 0.6f));
+    TextCacheDraw(UiFont(titleFontSize), title, titlePos, titleFontSize, 1, WHITE);
     
     // Subtitle with fade effect
     const char* subtitle = "A Game By Bismaya";
@@ -313,63 +857,64 @@ void DrawSplashScreen(Font font) {
     subtitleAlpha = sinf(GetTime() * 2) * 0.2f + 0.8f;
     
     Vector2 subtitlePos = {
-        SCREEN_WIDTH / 2 - MeasureTextEx(font, subtitle, 30, 1).x / 2,
+        SCREEN_WIDTH / 2 - TextCacheMeasure(UiFont(30), subtitle, 30, 1).x / 2,
         SCREEN_HEIGHT / 2 - 20
     };
-    DrawTextEx(font, subtitle, subtitlePos, 30, 1, ColorAlpha(COLOR_ACCENT, subtitleAlpha));
+    TextCacheDraw(UiFont(30), subtitle, subtitlePos, 30, 1, ColorAlpha(COLOR_ACCENT, subtitleAlpha));
     
     // Start button with enhanced animation
     static float pulseSize = 0;
     static bool pulsing = true;
     
+    float pulseStep = 0.01f * COSMETIC_TUNED_FPS * dt;
     if (pulsing) {
-        pulseSize += 0.01f;
+        pulseSize += pulseStep;
         if (pulseSize > 0.2f) pulsing = false;
     } else {
-        pulseSize -= 0.01f;
+        pulseSize -= pulseStep;
         if (pulseSize < 0.0f) pulsing = true;
     }
     
     const char* startText = "Click to Start";
     float startFontSize = 40 + pulseSize * 15;
     Vector2 startPos = {
-        SCREEN_WIDTH / 2 - MeasureTextEx(font, startText, startFontSize, 1).x / 2, 
+        SCREEN_WIDTH / 2 - MeasureTextEx(UiFont(startFontSize), startText, startFontSize, 1).x / 2, 
         SCREEN_HEIGHT / 2 + 80
     };
     
     // Glowing effect for start text
     Color startColor = ColorAlpha(WHITE, 0.8f + pulseSize);
-    DrawTextEx(font, startText, (Vector2){startPos.x + 3, startPos.y + 3}, startFontSize, 1, ColorAlpha(COLOR_ACCENT, 0.3f + pulseSize * 0.3f));
-    DrawTextEx(font, startText, startPos, startFontSize, 1, startColor);
+    DrawTextEx(UiFont(startFontSize), startText, (Vector2){startPos.x + 3, startPos.y + 3}, startFontSize, 1, ColorAlpha(COLOR_ACCENT, 0.3f + pulseSize * 0.3f));
+    DrawTextEx(UiFont(startFontSize), startText, startPos, startFontSize, 1, startColor);
     
     // Modern fullscreen button
     const char* fullscreenText = "Press F for Fullscreen";
     Vector2 fullscreenPos = {
-        SCREEN_WIDTH / 2 - MeasureTextEx(font, fullscreenText, 20, 1).x / 2,
+        SCREEN_WIDTH / 2 - TextCacheMeasure(UiFont(20), fullscreenText, 20, 1).x / 2,
         SCREEN_HEIGHT - 30
     };
     
     Rectangle fsRect = {
         fullscreenPos.x - 10,
         fullscreenPos.y - 5,
-        MeasureTextEx(font, fullscreenText, 20, 1).x + 20,
+        TextCacheMeasure(UiFont(20), fullscreenText, 20, 1).x + 20,
         30
     };
     
     DrawRectangleRounded(fsRect, 0.5f, 8, ColorAlpha(BLACK, 0.3f));
     DrawRectangleRoundedLines(fsRect, 0.5f, 8, ColorAlpha(COLOR_ACCENT, 0.5f + sinf(GetTime() * 3) * 0.2f));
-    DrawTextEx(font, fullscreenText, fullscreenPos, 20, 1, ColorAlpha(WHITE, 0.5f + sinf(GetTime() * 3) * 0.2f));
+    TextCacheDraw(UiFont(20), fullscreenText, fullscreenPos, 20, 1, ColorAlpha(WHITE, 0.5f + sinf(GetTime() * 3) * 0.2f));
 
     EndDrawing();
 }
 
 void UpdateSplashScreen(Game *game) {
-    if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON) || IsKeyPressed(KEY_SPACE)) {
+    if (InputMouseButtonPressed(&game->input.frame, MOUSE_LEFT_BUTTON) || InputKeyPressed(&game->input.frame, KEY_SPACE)) {
         game->state = STATE_MODE_SELECT;  // Go to mode selection instead of directly to game
     }
 }
 
-void DrawModeSelect(Font font, Game *game) {
+void DrawModeSelect(Game *game) {
     BeginDrawing();
     
     // Enhanced animated gradient background
@@ -377,25 +922,18 @@ void DrawModeSelect(Font font, Game *game) {
     Color bottomColor = COLOR_BACKGROUND;
     Color accentGlow = ColorAlpha(COLOR_ACCENT, 0.1f + sinf(GetTime() * 2) * 0.05f);
     
-    for (int y = 0; y < SCREEN_HEIGHT; y++) {
-        float factor = (float)y / SCREEN_HEIGHT;
-        Color lineColor = {
-            (unsigned char)Lerp(topColor.r, bottomColor.r, factor),
-            (unsigned char)Lerp(topColor.g, bottomColor.g, factor),
-            (unsigned char)Lerp(topColor.b, bottomColor.b, factor),
-            255
-        };
-        DrawLine(0, y, SCREEN_WIDTH, y, lineColor);
-    }
+    BackgroundDraw(topColor, bottomColor, SCREEN_WIDTH, SCREEN_HEIGHT);
     
     // Draw animated elements in background
     float time = GetTime();
     for (int i = 0; i < 40; i++) {
         float size = 3.0f + sinf(time * 0.5f + i * 0.2f) * 2.0f;
         float alpha = 0.1f + sinf(time * 0.3f + i * 0.7f) * 0.05f;
-        DrawCircle(
-            sinf(time * 0.1f + i * 1.1f) * SCREEN_WIDTH * 0.5f + SCREEN_WIDTH * 0.5f,
-            cosf(time * 0.2f + i * 0.8f) * SCREEN_HEIGHT * 0.5f + SCREEN_HEIGHT * 0.5f,
+        ParticleDrawDot(
+            (Vector2){
+                sinf(time * 0.1f + i * 1.1f) * SCREEN_WIDTH * 0.5f + SCREEN_WIDTH * 0.5f,
+                cosf(time * 0.2f + i * 0.8f) * SCREEN_HEIGHT * 0.5f + SCREEN_HEIGHT * 0.5f
+            },
             size,
             ColorAlpha(COLOR_ACCENT, alpha)
         );
@@ -404,28 +942,28 @@ void DrawModeSelect(Font font, Game *game) {
     // Animated title with floating effect
     float titleOffset = sinf(time * 1.5f) * 5.0f;
     Vector2 titlePos = {
-        SCREEN_WIDTH / 2 - MeasureTextEx(font, "SELECT GAME MODE", 60, 1).x / 2,
+        SCREEN_WIDTH / 2 - TextCacheMeasure(UiFont(60), "SELECT GAME MODE", 60, 1).x / 2,
         SCREEN_HEIGHT / 4 + titleOffset
     };
     
     // Draw title glow
-    DrawTextEx(font, "SELECT GAME MODE", (Vector2){titlePos.x + 4, titlePos.y + 4}, 60, 1, ColorAlpha(COLOR_ACCENT, 0.4f));
-    DrawTextEx(font, "SELECT GAME MODE", (Vector2){titlePos.x + 2, titlePos.y + 2}, 60, 1, ColorAlpha(COLOR_ACCENT, 0.6f));
-    DrawTextEx(font, "SELECT GAME MODE", titlePos, 60, 1, WHITE);
+    TextCacheDraw(UiFont(60), "SELECT GAME MODE", (Vector2){titlePos.x + 4, titlePos.y + 4}, 60, 1, ColorAlpha(COLOR_ACCENT, 0.4f));
+    TextCacheDraw(UiFont(60), "SELECT GAME MODE", (Vector2){titlePos.x + 2, titlePos.y + 2}, 60, 1, ColorAlpha(COLOR_ACCENT, 0.6f));
+    TextCacheDraw(UiFont(60), "SELECT GAME MODE", titlePos, 60, 1, WHITE);
     
     // Hover animations for mode options
-    Vector2 mousePos = GetMousePosition();
+    Vector2 mousePos = MousePosition(game);
     
     // Mode 1 animation
     const char* mode1Text = "1. Player vs AI";
     Vector2 mode1Pos = {
-        SCREEN_WIDTH / 2 - MeasureTextEx(font, mode1Text, 40, 1).x / 2,
+        SCREEN_WIDTH / 2 - TextCacheMeasure(UiFont(40), mode1Text, 40, 1).x / 2,
         SCREEN_HEIGHT / 2 - 20
     };
     
     Rectangle mode1Bounds = {
         mode1Pos.x - 20, mode1Pos.y - 10, 
-        MeasureTextEx(font, mode1Text, 40, 1).x + 40, 60
+        TextCacheMeasure(UiFont(40), mode1Text, 40, 1).x + 40, 60
     };
     
     bool mode1Hover = CheckCollisionPointRec(mousePos, mode1Bounds);
@@ -435,23 +973,23 @@ void DrawModeSelect(Font font, Game *game) {
     // Draw mode1 option with glow when hovered
     if (mode1Hover) {
         DrawRectangleRounded(mode1Bounds, 0.3f, 8, ColorAlpha(COLOR_ACCENT, 0.2f));
-        DrawTextEx(font, mode1Text, 
-                  (Vector2){mode1Pos.x - (mode1Scale-1.0f)*MeasureTextEx(font, mode1Text, 40, 1).x/2, mode1Pos.y}, 
+        TextCacheDraw(UiFont(40 * mode1Scale), mode1Text, 
+                  (Vector2){mode1Pos.x - (mode1Scale-1.0f)*TextCacheMeasure(UiFont(40), mode1Text, 40, 1).x/2, mode1Pos.y}, 
                   40 * mode1Scale, 1, mode1Color);
     } else {
-        DrawTextEx(font, mode1Text, mode1Pos, 40, 1, mode1Color);
+        TextCacheDraw(UiFont(40), mode1Text, mode1Pos, 40, 1, mode1Color);
     }
     
     // Mode 2 animation
     const char* mode2Text = "2. Player vs Player";
     Vector2 mode2Pos = {
-        SCREEN_WIDTH / 2 - MeasureTextEx(font, mode2Text, 40, 1).x / 2,
+        SCREEN_WIDTH / 2 - TextCacheMeasure(UiFont(40), mode2Text, 40, 1).x / 2,
         SCREEN_HEIGHT / 2 + 40
     };
     
     Rectangle mode2Bounds = {
         mode2Pos.x - 20, mode2Pos.y - 10, 
-        MeasureTextEx(font, mode2Text, 40, 1).x + 40, 60
+        TextCacheMeasure(UiFont(40), mode2Text, 40, 1).x + 40, 60
     };
     
     bool mode2Hover = CheckCollisionPointRec(mousePos, mode2Bounds);
@@ -461,19 +999,31 @@ void DrawModeSelect(Font font, Game *game) {
     // Draw mode2 option with glow when hovered
     if (mode2Hover) {
         DrawRectangleRounded(mode2Bounds, 0.3f, 8, ColorAlpha(COLOR_ACCENT, 0.2f));
-        DrawTextEx(font, mode2Text, 
-                  (Vector2){mode2Pos.x - (mode2Scale-1.0f)*MeasureTextEx(font, mode2Text, 40, 1).x/2, mode2Pos.y}, 
+        TextCacheDraw(UiFont(40 * mode2Scale), mode2Text, 
+                  (Vector2){mode2Pos.x - (mode2Scale-1.0f)*TextCacheMeasure(UiFont(40), mode2Text, 40, 1).x/2, mode2Pos.y}, 
                   40 * mode2Scale, 1, mode2Color);
     } else {
-        DrawTextEx(font, mode2Text, mode2Pos, 40, 1, mode2Color);
+        TextCacheDraw(UiFont(40), mode2Text, mode2Pos, 40, 1, mode2Color);
+    }
+    
+    // AI difficulty selector
+    char difficultyText[48];
+    sprintf(difficultyText, "AI Difficulty: <  %s  >", SimAiTierName(game->aiTier));
+    Rectangle difficultyBounds = AiDifficultyBounds(game);
+    bool difficultyHover = CheckCollisionPointRec(mousePos, difficultyBounds);
+    if (difficultyHover) {
+        DrawRectangleRounded(difficultyBounds, 0.3f, 8, ColorAlpha(COLOR_ACCENT, 0.2f));
     }
+    TextCacheDraw(UiFont(25), difficultyText,
+              (Vector2){ difficultyBounds.x + 10, difficultyBounds.y + 5 }, 25, 1,
+              difficultyHover ? WHITE : LIGHTGRAY);
     
     // Enhanced slider with animations
     Vector2 sliderLabelPos = {
-        SCREEN_WIDTH / 2 - MeasureTextEx(font, "Ball Speed:", 30, 1).x - 50,
+        SCREEN_WIDTH / 2 - TextCacheMeasure(UiFont(30), "Ball Speed:", 30, 1).x - 50,
         SCREEN_HEIGHT * 3/4 - 50
     };
-    DrawTextEx(font, "Ball Speed:", sliderLabelPos, 30, 1, WHITE);
+    TextCacheDraw(UiFont(30), "Ball Speed:", sliderLabelPos, 30, 1, WHITE);
     
     // Draw slider with glow effect
     Rectangle sliderBg = { 
@@ -507,11 +1057,11 @@ void DrawModeSelect(Font font, Game *game) {
     sprintf(speedText, "%.1fx", game->ballSpeedMultiplier);
     Vector2 speedTextPos = {
         // Inside the slider, centered
-        // sliderBg.x + (sliderBg.width - MeasureTextEx(font, speedText, 25, 1).x) / 2,
-        // sliderBg.y + (sliderBg.height - MeasureTextEx(font, speedText, 25, 1).y) / 2
+        // sliderBg.x + (sliderBg.width - MeasureTextEx(UiFont(25), speedText, 25, 1).x) / 2,
+        // sliderBg.y + (sliderBg.height - MeasureTextEx(UiFont(25), speedText, 25, 1).y) / 2
         // In front of the Ball Speed label
-        sliderLabelPos.x + MeasureTextEx(font, "Ball Speed:", 30, 1).x + 10,
-        sliderLabelPos.y + (sliderBg.height - MeasureTextEx(font, speedText, 25, 1).y) / 2 + 5
+        sliderLabelPos.x + TextCacheMeasure(UiFont(30), "Ball Speed:", 30, 1).x + 10,
+        sliderLabelPos.y + (sliderBg.height - TextCacheMeasure(UiFont(25), speedText, 25, 1).y) / 2 + 5
     };
     
     // Animate the speed text when it changes
@@ -523,16 +1073,16 @@ void DrawModeSelect(Font font, Game *game) {
         prevSpeed = game->ballSpeedMultiplier;
     }
     
-    speedAnimScale = Lerp(speedAnimScale, 1.0f, 0.1f);
+    speedAnimScale = Lerp(speedAnimScale, 1.0f, 1.0f - CosmeticDecay(0.9f, CosmeticDeltaTime()));
     
-    DrawTextEx(font, speedText, speedTextPos, 25 * speedAnimScale, 1, 
+    DrawTextEx(UiFont(25 * speedAnimScale), speedText, speedTextPos, 25 * speedAnimScale, 1, 
               ColorAlpha(WHITE, 0.7f + (speedAnimScale - 1.0f) * 1.5f));
     
     // Draw slider indicators with subtle animation
     float indicatorAlpha = 0.6f + sinf(GetTime() * 2) * 0.2f;
-    DrawTextEx(font, "Slow", (Vector2){ sliderBg.x - 40, sliderBg.y }, 20, 1, 
+    TextCacheDraw(UiFont(20), "Slow", (Vector2){ sliderBg.x - 40, sliderBg.y }, 20, 1, 
               ColorAlpha(LIGHTGRAY, indicatorAlpha));
-    DrawTextEx(font, "Fast", (Vector2){ sliderBg.x + sliderBg.width + 10, sliderBg.y }, 20, 1, 
+    TextCacheDraw(UiFont(20), "Fast", (Vector2){ sliderBg.x + sliderBg.width + 10, sliderBg.y }, 20, 1, 
               ColorAlpha(LIGHTGRAY, indicatorAlpha));
     
     // Controls information with modern styling
@@ -548,40 +1098,56 @@ void DrawModeSelect(Font font, Game *game) {
     
     const char* controlsText = "Player 1: W/S    Player 2: UP/DOWN";
     Vector2 controlsPos = {
-        SCREEN_WIDTH / 2 - MeasureTextEx(font, controlsText, 20, 1).x / 2,
+        SCREEN_WIDTH / 2 - TextCacheMeasure(UiFont(20), controlsText, 20, 1).x / 2,
         SCREEN_HEIGHT * 3/4 + 60
     };
-    DrawTextEx(font, controlsText, controlsPos, 20, 1, WHITE);
+    TextCacheDraw(UiFont(20), controlsText, controlsPos, 20, 1, WHITE);
     
     // Animated fullscreen instruction
     float fsAlpha = 0.5f + sinf(GetTime() * 3) * 0.2f;
     const char* fullscreenText = "Press F for Fullscreen";
     Vector2 fullscreenPos = {
-        SCREEN_WIDTH / 2 - MeasureTextEx(font, fullscreenText, 20, 1).x / 2,
+        SCREEN_WIDTH / 2 - TextCacheMeasure(UiFont(20), fullscreenText, 20, 1).x / 2,
         SCREEN_HEIGHT - 30
     };
     
     Rectangle fsRect = {
         fullscreenPos.x - 10,
         fullscreenPos.y - 5,
-        MeasureTextEx(font, fullscreenText, 20, 1).x + 20,
+        TextCacheMeasure(UiFont(20), fullscreenText, 20, 1).x + 20,
         30
     };
     
     DrawRectangleRounded(fsRect, 0.5f, 8, ColorAlpha(BLACK, 0.3f));
     DrawRectangleRoundedLines(fsRect, 0.5f, 8, accentGlow);
-    DrawTextEx(font, fullscreenText, fullscreenPos, 20, 1, ColorAlpha(WHITE, fsAlpha));
+    TextCacheDraw(UiFont(20), fullscreenText, fullscreenPos, 20, 1, ColorAlpha(WHITE, fsAlpha));
 
     EndDrawing();
 }
 
+// Clickable area of the AI difficulty selector on the mode select screen
+Rectangle AiDifficultyBounds(const Game *game) {
+    char text[48];
+    sprintf(text, "AI Difficulty: <  %s  >", SimAiTierName(game->aiTier));
+    float width = TextCacheMeasure(UiFont(25), text, 25, 1).x + 20;
+    return (Rectangle){ SCREEN_WIDTH / 2 - width / 2, SCREEN_HEIGHT / 2 + 110, width, 35 };
+}
+
 void UpdateModeSelect(Game *game) {
-    if (IsKeyPressed(KEY_ONE) || IsKeyPressed(KEY_KP_1)) {
+    const InputState *input = &game->input.frame;
+    if (InputKeyPressed(input, KEY_ONE) || InputKeyPressed(input, KEY_KP_1)) {
         InitGame(game, MODE_AI);
-    } else if (IsKeyPressed(KEY_TWO) || IsKeyPressed(KEY_KP_2)) {
+    } else if (InputKeyPressed(input, KEY_TWO) || InputKeyPressed(input, KEY_KP_2)) {
         InitGame(game, MODE_MULTIPLAYER);
     }
     
+    // Cycle the AI difficulty with LEFT/RIGHT or by clicking the selector
+    if (InputKeyPressed(input, KEY_LEFT)) {
+        game->aiTier = (SimAiTier)((game->aiTier + SIM_AI_TIER_COUNT - 1) % SIM_AI_TIER_COUNT);
+    } else if (InputKeyPressed(input, KEY_RIGHT)) {
+        game->aiTier = (SimAiTier)((game->aiTier + 1) % SIM_AI_TIER_COUNT);
+    }
+    
     // Handle slider interaction
     Rectangle sliderBg = { 
         SCREEN_WIDTH / 2 - 150, 
@@ -596,12 +1162,12 @@ void UpdateModeSelect(Game *game) {
         sliderBg.width, sliderBg.height + 20
     };
     
-    Vector2 mousePos = GetMousePosition();
+    Vector2 mousePos = MousePosition(game);
     
     // Check if mouse is over slider or if dragging
     static bool dragging = false;
     
-    if (IsMouseButtonDown(MOUSE_LEFT_BUTTON)) {
+    if (InputMouseButtonDown(input, MOUSE_LEFT_BUTTON)) {
         if (dragging || CheckCollisionPointRec(mousePos, sliderHitArea)) {
             dragging = true;
             
@@ -631,8 +1197,14 @@ void UpdateModeSelect(Game *game) {
         60
     };
     
-    if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
-        if (CheckCollisionPointRec(mousePos, mode1Bounds)) {
+    Rectangle difficultyBounds = AiDifficultyBounds(game);
+    
+    if (InputMouseButtonPressed(input, MOUSE_LEFT_BUTTON)) {
+        if (CheckCollisionPointRec(mousePos, difficultyBounds)) {
+            // Left half steps down, right half steps up
+            int step = (mousePos.x < difficultyBounds.x + difficultyBounds.width / 2) ? SIM_AI_TIER_COUNT - 1 : 1;
+            game->aiTier = (SimAiTier)((game->aiTier + step) % SIM_AI_TIER_COUNT);
+        } else if (CheckCollisionPointRec(mousePos, mode1Bounds)) {
             InitGame(game, MODE_AI);
         } else if (CheckCollisionPointRec(mousePos, mode2Bounds)) {
             InitGame(game, MODE_MULTIPLAYER);
@@ -644,183 +1216,119 @@ void InitGame(Game *game, GameMode mode) {
     // Set game mode
     game->mode = mode;
     
-    // Reset game state
+    // Reset game state and rules
     game->state = STATE_PLAYING;
-    game->playerScore = 0;
-    game->aiScore = 0;
-    game->winScore = 10;
-    
-    // Initialize ball with modern styling
-    game->ball.radius = BALL_RADIUS;
-    game->ball.color = COLOR_BALL;
-    
-    // Initialize player paddle with modern styling
-    game->playerPaddle.rect = (Rectangle){
-        10, 
-        (SCREEN_HEIGHT - PADDLE_HEIGHT) / 2, 
-        PADDLE_WIDTH, 
-        PADDLE_HEIGHT
-    };
-    game->playerPaddle.speed = PADDLE_SPEED;
-    game->playerPaddle.color = COLOR_PLAYER_ONE;
-    
-    // Initialize AI or second player paddle with modern styling
-    game->aiPaddle.rect = (Rectangle){
-        SCREEN_WIDTH - 10 - PADDLE_WIDTH,
-        (SCREEN_HEIGHT - PADDLE_HEIGHT) / 2,
-        PADDLE_WIDTH,
-        PADDLE_HEIGHT
-    };
-    game->aiPaddle.speed = PADDLE_SPEED;
-    game->aiPaddle.color = (mode == MODE_AI) ? COLOR_AI : COLOR_PLAYER_TWO;
+    uint64_t seed = game->requestedSeed ? game->requestedSeed : TimerNowNs();
+    int winScore = SIM_DEFAULT_WIN_SCORE;
+    if (game->playingBack) {
+        ReplayReaderRewind(&game->playback);
+        seed = game->playback.header.seed;
+        winScore = game->playback.header.winScore;
+    } else if (mode == MODE_ONLINE) {
+        // The host's settings (sent to the client during the handshake)
+        seed = game->net->seed;
+        winScore = game->net->winScore;
+        game->ballSpeedMultiplier = game->net->ballSpeedMultiplier;
+    }
+    SimInit(&game->sim, game->ballSpeedMultiplier, winScore, seed);
+    if (game->playingBack) {
+        // Replay the AI exactly as it was tuned when the match was recorded
+        for (int side = SIM_SIDE_LEFT; side <= SIM_SIDE_RIGHT; side++) {
+            if (game->playback.header.aiControlled[side]) {
+                SimSetAi(&game->sim, (SimSide)side, &game->playback.header.aiProfile[side]);
+            }
+        }
+    } else if (game->benchmark) {
+        // Scripted runs: the built-in AI plays both paddles in either mode
+        for (int side = SIM_SIDE_LEFT; side <= SIM_SIDE_RIGHT; side++) {
+            SimSetAi(&game->sim, (SimSide)side, SimAiTierProfile(game->aiTier));
+        }
+    } else if (mode == MODE_AI) {
+        SimSetAi(&game->sim, SIM_SIDE_RIGHT, SimAiTierProfile(game->aiTier));
+    }
+    RngSeed(&game->cosmeticRng, seed, RNG_STREAM_COSMETIC);
+    
+    // Start a fresh recording for this match. Online inputs can still be
+    // rolled back after a tick runs, so those matches aren't recorded.
+    ReplayWriterClose(game->recorder);
+    game->recorder = NULL;
+    if (game->recordPath != NULL && !game->playingBack && mode != MODE_ONLINE) {
+        ReplayHeader header = {
+            .seed = seed,
+            .ballSpeedMultiplier = game->ballSpeedMultiplier,
+            .winScore = winScore,
+            .aiControlled = { game->benchmark, game->benchmark || mode == MODE_AI },
+            .aiProfile = { game->sim.ai[SIM_SIDE_LEFT].profile, game->sim.ai[SIM_SIDE_RIGHT].profile }
+        };
+        game->recorder = ReplayWriterOpen(game->recordPath, &header);
+        if (game->recorder == NULL) {
+            TraceLog(LOG_WARNING, "Could not record replay to %s", game->recordPath);
+        }
+    }
+    
+    // Paddle colors for the chosen mode
+    game->playerColor = COLOR_PLAYER_ONE;
+    game->opponentColor = (mode == MODE_AI) ? COLOR_AI : COLOR_PLAYER_TWO;
     
-    // Reset ball with player serving
-    ResetBall(game, true);
-
     // Initialize particle system
-    game->activeParticles = 0;
+    ParticleClear(&game->particles);
     
     // Initialize animation values
     game->scoreAnimScale = 1.0f;
     game->lastScoreTime = 0;
     game->screenShake = 0;
     game->shakeOffset = (Vector2){0, 0};
+
+    // Start the fixed-step clock with no interpolation history
+    game->accumulator = 0.0f;
+    game->renderAlpha = 0.0f;
+    game->prevBallPosition = (Vector2){ game->sim.ball.position.x, game->sim.ball.position.y };
+    game->prevPlayerPaddleY = game->sim.paddles[SIM_SIDE_LEFT].rect.y;
+    game->prevAiPaddleY = game->sim.paddles[SIM_SIDE_RIGHT].rect.y;
 }
 
 void UpdateGame(Game *game) {
+    if (game->net != NULL) {
+        UpdateOnline(game);
+        return;
+    }
+    
+    if (game->playingBack) {
+        UpdatePlaybackControls(game);
+    }
+    
     switch (game->state) {
         case STATE_PLAYING:
             // Toggle pause
-            if (IsKeyPressed(KEY_P)) {
+            if (InputKeyPressed(&game->input.frame, KEY_P)) {
                 game->state = STATE_PAUSED;
                 return;
             }
             
-            // Handle player 1 paddle movement
-            float playerMovement = 0.0f;
-            if (IsKeyDown(KEY_W)) playerMovement -= game->playerPaddle.speed;
-            if (IsKeyDown(KEY_S)) playerMovement += game->playerPaddle.speed;
-            
-            game->playerPaddle.rect.y += playerMovement;
-            
-            // Clamp player paddle position to screen bounds
-            game->playerPaddle.rect.y = Clamp(
-                game->playerPaddle.rect.y, 
-                0, 
-                SCREEN_HEIGHT - game->playerPaddle.rect.height
-            );
-            
-            // Handle second paddle (AI or Player 2)
-            if (game->mode == MODE_AI) {
-                // AI controls the paddle - pass the game object for ball speed info
-                UpdateAI(&game->aiPaddle, &game->ball, game);
-            } else {
-                // Player 2 controls the paddle
-                float player2Movement = 0.0f;
-                if (IsKeyDown(KEY_UP)) player2Movement -= game->aiPaddle.speed;
-                if (IsKeyDown(KEY_DOWN)) player2Movement += game->aiPaddle.speed;
-                
-                game->aiPaddle.rect.y += player2Movement;
-                
-                // Clamp player 2 paddle position to screen bounds
-                game->aiPaddle.rect.y = Clamp(
-                    game->aiPaddle.rect.y, 
-                    0, 
-                    SCREEN_HEIGHT - game->aiPaddle.rect.height
-                );
-            }
-            
-            // Update ball position
-            game->ball.position.x += game->ball.velocity.x;
-            game->ball.position.y += game->ball.velocity.y;
-            
-            // Ball collision with top and bottom walls
-            if (game->ball.position.y - game->ball.radius <= 0 || 
-                game->ball.position.y + game->ball.radius >= SCREEN_HEIGHT) {
-                
-                game->ball.velocity.y *= -1.0f;
-                
-                // Ensure ball doesn't get stuck in walls
-                if (game->ball.position.y < game->ball.radius) {
-                    game->ball.position.y = game->ball.radius + WALL_BOUNCE_BUFFER;
-                }
-                if (game->ball.position.y > SCREEN_HEIGHT - game->ball.radius) {
-                    game->ball.position.y = SCREEN_HEIGHT - game->ball.radius - WALL_BOUNCE_BUFFER;
-                }
-            }
-            
-            // Check for paddle collisions
-            if (CheckPaddleCollision(&game->ball, &game->playerPaddle, game)) {
-                // Calculate normalized hit position (-0.5 to 0.5)
-                float hitPosition = (game->ball.position.y - (game->playerPaddle.rect.y + game->playerPaddle.rect.height/2)) / 
-                                    (game->playerPaddle.rect.height/2);
-                
-                // Make the ball faster with each hit, using adjusted max speed
-                float adjustedMaxSpeed = MAX_BALL_SPEED * game->ballSpeedMultiplier;
-                float speed = fminf(fabs(game->ball.velocity.x) + SPEED_INCREMENT, adjustedMaxSpeed);
-                
-                // Set new velocity based on hit position (affects angle)
-                game->ball.velocity.x = speed;
-                game->ball.velocity.y = hitPosition * (speed * 0.75f);
-                
-                // Play hit sound
-                PlaySound(game->paddleHitSound);
-                game->screenShake = 5.0f;
-                
-                // Create particle effect
-                CreateParticleEffect(game, game->ball.position, ColorAlpha(WHITE, 0.8f), 15);
-            }
-
-            if (CheckPaddleCollision(&game->ball, &game->aiPaddle, game)) {
-                // Calculate normalized hit position (-0.5 to 0.5)
-                float hitPosition = (game->ball.position.y - (game->aiPaddle.rect.y + game->aiPaddle.rect.height/2)) / 
-                                    (game->aiPaddle.rect.height/2);
-                
-                // Make the ball faster with each hit, using adjusted max speed
-                float adjustedMaxSpeed = MAX_BALL_SPEED * game->ballSpeedMultiplier;
-                float speed = fminf(fabs(game->ball.velocity.x) + SPEED_INCREMENT, adjustedMaxSpeed);
-                
-                // Set new velocity based on hit position (affects angle)
-                game->ball.velocity.x = -speed;
-                game->ball.velocity.y = hitPosition * (speed * 0.75f);
-                
-                // Play hit sound
-                PlaySound(game->paddleHitSound);
-                game->screenShake = 5.0f;
-                
-                // Create particle effect
-                CreateParticleEffect(game, game->ball.position, ColorAlpha(WHITE, 0.8f), 15);
-            }
-            
-            // Ball out of bounds - scoring
-            if (game->ball.position.x < -BALL_RADIUS) {
-                game->aiScore++;
-                PlaySound(game->scoreSound);
-                ResetBall(game, false);
-            } else if (game->ball.position.x > SCREEN_WIDTH + BALL_RADIUS) {
-                game->playerScore++;
-                PlaySound(game->scoreSound);
-                ResetBall(game, true);
+            // Run as many fixed physics ticks as the elapsed frame time covers
+            game->accumulator += FrameDeltaTime();
+            while (game->accumulator >= SIM_DT && game->state == STATE_PLAYING) {
+                StepGame(game);
+                game->accumulator -= SIM_DT;
             }
             
-            // Check for game over
-            if (game->playerScore >= game->winScore || game->aiScore >= game->winScore) {
-                game->state = STATE_GAME_OVER;
-            }
+            // Leftover time decides how far between the last two ticks we draw
+            game->renderAlpha = game->accumulator / SIM_DT;
             break;
             
         case STATE_PAUSED:
             // Resume game if P is pressed again
-            if (IsKeyPressed(KEY_P)) {
+            if (InputKeyPressed(&game->input.frame, KEY_P)) {
                 game->state = STATE_PLAYING;
+                game->accumulator = 0.0f;
             }
             break;
             
         case STATE_GAME_OVER:
             // Restart game if R is pressed
-            if (IsKeyPressed(KEY_R)) {
+            if (InputKeyPressed(&game->input.frame, KEY_R)) {
                 InitGame(game, game->mode);  // Keep same mode
-            } else if (IsKeyPressed(KEY_M)) {
+            } else if (InputKeyPressed(&game->input.frame, KEY_M)) {
                 game->state = STATE_MODE_SELECT;  // Go back to mode selection
             }
             break;
@@ -831,15 +1339,235 @@ void UpdateGame(Game *game) {
     }
 }
 
+// Advance the simulation by exactly one fixed tick (SIM_DT)
+void StepGame(Game *game) {
+    // Remember where everything was so DrawGame can interpolate
+    game->prevBallPosition = (Vector2){ game->sim.ball.position.x, game->sim.ball.position.y };
+    game->prevPlayerPaddleY = game->sim.paddles[SIM_SIDE_LEFT].rect.y;
+    game->prevAiPaddleY = game->sim.paddles[SIM_SIDE_RIGHT].rect.y;
+    
+    // Input that arrived up to the end of this tick, and no later. Gamepads
+    // are read again first: a tick whose span reaches the present gets the
+    // stick as it is now, while catch-up ticks for time already past keep
+    // the samples taken during their own span.
+    if (InputCapturePollGamepads()) InputCollect(&game->input, TimerNowNs());
+    InputBeginTick(&game->input, TickInputEndNs(game), SIM_TICK_NS);
+    const InputState *keys = &game->input.tick;
+    
+    SimEvent events[SIM_MAX_EVENTS];
+    int eventCount = 0;
+    
+    if (game->net != NULL) {
+        // Our paddle moves now; the other one is predicted and corrected later
+        int8_t axis = PaddleAxis(keys, (InputKeyActive(keys, KEY_S) || InputKeyActive(keys, KEY_DOWN)) -
+                                       (InputKeyActive(keys, KEY_W) || InputKeyActive(keys, KEY_UP)), 0);
+        NetplayAdvance(game->net, &game->sim, axis, events, &eventCount);
+        // A correction can also undo (or bring about) the final point
+        game->state = game->sim.matchOver ? STATE_GAME_OVER : STATE_PLAYING;
+    } else {
+        SimInput input;
+        if (game->playingBack) {
+            if (!ReplayReaderNext(&game->playback, &input)) {
+                // Recording ended before the match did (player quit mid-match)
+                game->state = STATE_PAUSED;
+                return;
+            }
+        } else if (game->benchmark) {
+            input = ScriptedInput();
+        } else {
+            input = ReadPlayerInput(game);
+        }
+        
+        if (game->recorder != NULL) {
+            ReplayWriterRecord(game->recorder, &game->sim, &input);
+        }
+        
+        eventCount = SimStep(&game->sim, &input, events);
+    }
+    
+    for (int i = 0; i < eventCount; i++) {
+        HandleSimEvent(game, &events[i]);
+    }
+}
+
+// Online match. There is no pause (the other side keeps playing), and ticks
+// keep running after the final point so a late correction can still change
+// the result.
+void UpdateOnline(Game *game) {
+    Netplay *net = game->net;
+    NetplayPoll(net);
+    
+    if (game->state == STATE_CONNECTING) {
+        if (net->status == NET_STATUS_RUNNING) {
+            InitGame(game, MODE_ONLINE);
+        }
+        return;
+    }
+    
+    if (net->status != NET_STATUS_RUNNING || game->state == STATE_GAME_OVER) {
+        if (InputKeyPressed(&game->input.frame, KEY_M)) {
+            LeaveOnline(game);
+            game->state = STATE_MODE_SELECT;
+            return;
+        }
+    }
+    if (net->status != NET_STATUS_RUNNING) return;
+    
+    game->accumulator += FrameDeltaTime();
+    while (game->accumulator >= SIM_DT) {
+        StepGame(game);
+        game->accumulator -= SIM_DT;
+    }
+    game->renderAlpha = game->accumulator / SIM_DT;
+}
+
+void LeaveOnline(Game *game) {
+    if (game->net == NULL) return;
+    NetplayClose(game->net);
+    free(game->net);
+    game->net = NULL;
+}
+
+// Replay viewer: LEFT/RIGHT jump 5 seconds, hold SHIFT for 30
+void UpdatePlaybackControls(Game *game) {
+    const InputState *input = &game->input.frame;
+    int direction = InputKeyPressed(input, KEY_RIGHT) - InputKeyPressed(input, KEY_LEFT);
+    if (direction == 0) return;
+    
+    bool bigStep = InputKeyDown(input, KEY_LEFT_SHIFT) || InputKeyDown(input, KEY_RIGHT_SHIFT);
+    int64_t target = (int64_t)game->sim.frame + direction * (bigStep ? 30 : 5) * SIM_TICK_RATE;
+    if (target < 0) target = 0;
+    
+    ReplayReaderSeek(&game->playback, &game->sim, (uint32_t)target);
+    
+    // Jumping doesn't animate: snap the interpolation history and drop effects
+    game->prevBallPosition = (Vector2){ game->sim.ball.position.x, game->sim.ball.position.y };
+    game->prevPlayerPaddleY = game->sim.paddles[SIM_SIDE_LEFT].rect.y;
+    game->prevAiPaddleY = game->sim.paddles[SIM_SIDE_RIGHT].rect.y;
+    game->accumulator = 0.0f;
+    ParticleClear(&game->particles);
+    game->screenShake = 0;
+    game->state = game->sim.matchOver ? STATE_GAME_OVER : STATE_PLAYING;
+}
+
+// Map keyboard and gamepad state to sim controls for this tick. A key tapped
+// and let go within the tick still moves the paddle for it.
+SimInput ReadPlayerInput(const Game *game) {
+    SimInput input = { 0 };
+    const InputState *keys = &game->input.tick;
+    
+    // Player 1: W/S or the first gamepad
+    input.axis[SIM_SIDE_LEFT] = PaddleAxis(keys, InputKeyActive(keys, KEY_S) - InputKeyActive(keys, KEY_W), 0);
+    
+    // Second paddle: AI or Player 2 on UP/DOWN or the second gamepad
+    if (game->mode == MODE_AI) {
+        input.aiControlled[SIM_SIDE_RIGHT] = true;
+    } else {
+        input.axis[SIM_SIDE_RIGHT] = PaddleAxis(keys, InputKeyActive(keys, KEY_DOWN) - InputKeyActive(keys, KEY_UP), 1);
+    }
+    
+    return input;
+}
+
+// Benchmark input: nothing from the (hidden) window, the AI on both paddles,
+// so every run plays the same rallies
+SimInput ScriptedInput(void) {
+    return (SimInput){ .aiControlled = { true, true } };
+}
+
+// One player's paddle control. Keys (keyAxis: -1 up, 1 down) and the D-pad
+// move at full speed; otherwise the left stick, plus the right trigger down
+// and the left trigger up, set the speed through their response curves. The
+// analog values are averages over the tick, so the paddle covers the same
+// distance it would have moving continuously as the stick moved.
+int8_t PaddleAxis(const InputState *input, int keyAxis, int gamepad) {
+    int digital = keyAxis + InputGamepadButtonDown(input, gamepad, GAMEPAD_BUTTON_LEFT_FACE_DOWN) -
+                  InputGamepadButtonDown(input, gamepad, GAMEPAD_BUTTON_LEFT_FACE_UP);
+    if (digital != 0) return (int8_t)((digital > 0) ? SIM_AXIS_MAX : -SIM_AXIS_MAX);
+    
+    float analog = InputGamepadAxisMean(input, gamepad, GAMEPAD_AXIS_LEFT_Y) +
+                   InputGamepadAxisMean(input, gamepad, GAMEPAD_AXIS_RIGHT_TRIGGER) -
+                   InputGamepadAxisMean(input, gamepad, GAMEPAD_AXIS_LEFT_TRIGGER);
+    return (int8_t)lroundf(Clamp(analog, -1.0f, 1.0f) * SIM_AXIS_MAX);
+}
+
+// Latest input the tick about to run should see. A frame is drawn
+// renderAlpha of the way from the previous tick to the newest one, which puts
+// the newest tick SIM_DT - leftover after the start of the frame. Called
+// before the tick's SIM_DT is taken off the accumulator.
+uint64_t TickInputEndNs(const Game *game) {
+    double ahead = 2.0 * SIM_DT - game->accumulator;
+    uint64_t offset = (uint64_t)(fabs(ahead) * 1e9);
+    return (ahead >= 0.0) ? game->input.frameNs + offset : game->input.frameNs - offset;
+}
+
+// Whether this frame runs sim ticks to hand input to: local play, or an
+// online match once it is connected (including after the final point)
+bool TicksRunning(const Game *game) {
+    if (game->net != NULL) return game->state != STATE_CONNECTING && game->net->status == NET_STATUS_RUNNING;
+    return game->state == STATE_PLAYING;
+}
+
+// Cursor as of the start of this frame
+Vector2 MousePosition(const Game *game) {
+    return (Vector2){ game->input.frame.mouseX, game->input.frame.mouseY };
+}
+
+// Turn gameplay events from the sim into sound, particles and shake
+void HandleSimEvent(Game *game, const SimEvent *event) {
+    Vector2 position = { event->position.x, event->position.y };
+    
+    switch (event->type) {
+        case SIM_EVENT_PADDLE_HIT:
+            PlaySound(game->paddleHitSound);
+            game->screenShake = 5.0f;
+            game->shakeTimer = 0.0f;
+            CreateParticleEffect(game, position, ColorAlpha(WHITE, 0.8f), 15);
+            break;
+            
+        case SIM_EVENT_SCORE:
+            PlaySound(game->scoreSound);
+            ServeEffects(game, event->side == SIM_SIDE_LEFT);
+            // A serve teleports the ball, so don't interpolate across it
+            game->prevBallPosition = (Vector2){ game->sim.ball.position.x, game->sim.ball.position.y };
+            break;
+            
+        case SIM_EVENT_MATCH_OVER:
+            game->state = STATE_GAME_OVER;
+            // The recording is complete once someone has won
+            ReplayWriterClose(game->recorder);
+            game->recorder = NULL;
+            break;
+            
+        default:
+            break;
+    }
+}
+
 void DrawGame(Game *game) {
+    // Re-render the static court layer only if the window changed
+    ProfilerBegin(&game->profiler, PROFILE_COURT_BAKE);
+    CourtPrepare((Color){ 12, 20, 28, 255 }, COLOR_BACKGROUND, SCREEN_WIDTH, SCREEN_HEIGHT);
+    ProfilerEnd(&game->profiler, PROFILE_COURT_BAKE);
+    
     BeginDrawing();
+    if (game->benchmark) {
+        BeginTextureMode(game->offscreen);
+    }
     
     // Apply screen shake if active
-    game->screenShake *= 0.9f; // Dampen the shake effect over time
+    float dt = CosmeticDeltaTime();
+    game->screenShake *= CosmeticDecay(0.9f, dt); // Dampen the shake effect over time
     
     if (game->screenShake > 0.1f) {
-        game->shakeOffset.x = GetRandomValue(-10, 10) * (game->screenShake / 10.0f);
-        game->shakeOffset.y = GetRandomValue(-10, 10) * (game->screenShake / 10.0f);
+        // Jitter at a fixed rate so high frame rates don't turn it into a blur
+        game->shakeTimer -= dt;
+        if (game->shakeTimer <= 0.0f) {
+            game->shakeTimer += 1.0f / SHAKE_JITTER_RATE;
+            if (game->shakeTimer < 0.0f) game->shakeTimer = 0.0f;
+            game->shakeOffset.x = RngRange(&game->cosmeticRng, -10, 10) * (game->screenShake / 10.0f);
+            game->shakeOffset.y = RngRange(&game->cosmeticRng, -10, 10) * (game->screenShake / 10.0f);
+        }
     } else {
         game->shakeOffset = (Vector2){0, 0};
         game->screenShake = 0;
@@ -853,101 +1581,96 @@ void DrawGame(Game *game) {
         .zoom = 1.0f
     });
     
-    // Modern gradient background
-    Color topColor = (Color){ 12, 20, 28, 255 };
-    Color bottomColor = COLOR_BACKGROUND;
-    
-    for (int y = 0; y < SCREEN_HEIGHT; y++) {
-        float factor = (float)y / SCREEN_HEIGHT;
-        Color lineColor = {
-            (unsigned char)Lerp(topColor.r, bottomColor.r, factor),
-            (unsigned char)Lerp(topColor.g, bottomColor.g, factor),
-            (unsigned char)Lerp(topColor.b, bottomColor.b, factor),
-            255
-        };
-        DrawLine(0, y, SCREEN_WIDTH, y, lineColor);
-    }
-    
-    // Draw court lines and center circle
-    DrawLineEx(
-        (Vector2){ SCREEN_WIDTH/2, 0 },
-        (Vector2){ SCREEN_WIDTH/2, SCREEN_HEIGHT },
-        2,
-        ColorAlpha(WHITE, 0.3f)
-    );
-    
-    DrawCircleLines(SCREEN_WIDTH/2, SCREEN_HEIGHT/2, 100, ColorAlpha(WHITE, 0.3f));
-    
-    // Draw middle dashed line with smoother appearance
-    for (int i = 0; i < SCREEN_HEIGHT; i += 20) {
-        DrawRectangleRounded(
-            (Rectangle){ SCREEN_WIDTH/2 - 1, i, 2, 10 },
-            0.5f,
-            4,
-            ColorAlpha(WHITE, 0.5f)
-        );
-    }
+    // Gradient background and court markings, cached in one layer
+    ProfilerBegin(&game->profiler, PROFILE_COURT);
+    CourtDraw(SCREEN_WIDTH, SCREEN_HEIGHT);
+    ProfileDraws(game, PROFILE_COURT);
+    ProfilerEnd(&game->profiler, PROFILE_COURT);
+    
+    // Interpolate between the last two sim ticks so motion is smooth at any FPS
+    float alpha = (game->state == STATE_PLAYING) ? game->renderAlpha : 1.0f;
+    const SimRect *leftRect = &game->sim.paddles[SIM_SIDE_LEFT].rect;
+    const SimRect *rightRect = &game->sim.paddles[SIM_SIDE_RIGHT].rect;
+    Rectangle playerRect = { leftRect->x, Lerp(game->prevPlayerPaddleY, leftRect->y, alpha), leftRect->width, leftRect->height };
+    Rectangle aiRect = { rightRect->x, Lerp(game->prevAiPaddleY, rightRect->y, alpha), rightRect->width, rightRect->height };
+    Vector2 ballPosition = { game->sim.ball.position.x, game->sim.ball.position.y };
+    Vector2 ballPos = Vector2Lerp(game->prevBallPosition, ballPosition, alpha);
     
     // Draw paddles with rounded corners and glow
+    ProfilerBegin(&game->profiler, PROFILE_ENTITIES);
     DrawRoundedRectangleWithGlow(
-        game->playerPaddle.rect,
+        playerRect,
         0.3f,
         8,
-        game->playerPaddle.color
+        game->playerColor
     );
     
     DrawRoundedRectangleWithGlow(
-        game->aiPaddle.rect,
+        aiRect,
         0.3f,
         8,
-        game->aiPaddle.color
+        game->opponentColor
     );
     
     // Draw ball with glow effect
-    DrawBallWithGlow(game->ball.position, game->ball.radius, COLOR_BALL);
-    
-    // Update and draw particles
-    UpdateAndDrawParticles(game);
+    DrawBallWithGlow(ballPos, game->sim.ball.radius, COLOR_BALL);
+    ProfileDraws(game, PROFILE_ENTITIES);
+    ProfilerEnd(&game->profiler, PROFILE_ENTITIES);
+    
+    // Draw particles, all in one batch
+    uint64_t traceStart = TraceZoneBegin();
+    ProfilerBegin(&game->profiler, PROFILE_PARTICLES);
+    ParticleDrawSystem(&game->particles);
+    ProfileDraws(game, PROFILE_PARTICLES);
+    ProfilerEnd(&game->profiler, PROFILE_PARTICLES);
+    TraceZoneEnd("ParticleDrawSystem", traceStart);
     
     // Draw scores with shadow effect
+    ProfilerBegin(&game->profiler, PROFILE_HUD);
     char scoreText[8];
     const char* player1Label = "P1";
     const char* player2Label = (game->mode == MODE_AI) ? "AI" : "P2";
+    if (game->mode == MODE_ONLINE) {
+        bool hosting = game->net != NULL && game->net->isHost;
+        player1Label = hosting ? "YOU" : "HOST";
+        player2Label = hosting ? "GUEST" : "YOU";
+    }
     
     // Player 1 score shadow + text
-    sprintf(scoreText, "%d", game->playerScore);
+    sprintf(scoreText, "%d", game->sim.scores[SIM_SIDE_LEFT]);
     Vector2 playerScorePos = {
-        SCREEN_WIDTH/4 - MeasureTextEx(game->gameFont, scoreText, 80, 1).x/2,
+        SCREEN_WIDTH/4 - TextCacheMeasure(UiFont(80), scoreText, 80, 1).x/2,
         20
     };
     Vector2 scoreShadowPos = { playerScorePos.x + 3, playerScorePos.y + 3 };
-    DrawTextEx(game->gameFont, scoreText, scoreShadowPos, 80, 1, ColorAlpha(BLACK, 0.5f));
-    DrawTextEx(game->gameFont, scoreText, playerScorePos, 80, 1, WHITE);
+    TextCacheDraw(UiFont(80), scoreText, scoreShadowPos, 80, 1, ColorAlpha(BLACK, 0.5f));
+    TextCacheDraw(UiFont(80), scoreText, playerScorePos, 80, 1, WHITE);
     
     // Player 1 label
     Vector2 player1LabelPos = {
-        SCREEN_WIDTH/4 - MeasureTextEx(game->gameFont, player1Label, 24, 1).x/2,
+        SCREEN_WIDTH/4 - TextCacheMeasure(UiFont(24), player1Label, 24, 1).x/2,
         110
     };
-    DrawTextEx(game->gameFont, player1Label, player1LabelPos, 24, 1, game->playerPaddle.color);
+    TextCacheDraw(UiFont(24), player1Label, player1LabelPos, 24, 1, game->playerColor);
     
     // Player 2 / AI score shadow + text
-    sprintf(scoreText, "%d", game->aiScore);
+    sprintf(scoreText, "%d", game->sim.scores[SIM_SIDE_RIGHT]);
     Vector2 aiScorePos = {
-        3*SCREEN_WIDTH/4 - MeasureTextEx(game->gameFont, scoreText, 80, 1).x/2,
+        3*SCREEN_WIDTH/4 - TextCacheMeasure(UiFont(80), scoreText, 80, 1).x/2,
         20
     };
     scoreShadowPos = (Vector2){ aiScorePos.x + 3, aiScorePos.y + 3 };
-    DrawTextEx(game->gameFont, scoreText, scoreShadowPos, 80, 1, ColorAlpha(BLACK, 0.5f));
-    DrawTextEx(game->gameFont, scoreText, aiScorePos, 80, 1, WHITE);
+    TextCacheDraw(UiFont(80), scoreText, scoreShadowPos, 80, 1, ColorAlpha(BLACK, 0.5f));
+    TextCacheDraw(UiFont(80), scoreText, aiScorePos, 80, 1, WHITE);
     
     // Player 2 / AI label
     Vector2 player2LabelPos = {
-        3*SCREEN_WIDTH/4 - MeasureTextEx(game->gameFont, player2Label, 24, 1).x/2,
+        3*SCREEN_WIDTH/4 - TextCacheMeasure(UiFont(24), player2Label, 24, 1).x/2,
         110
     };
-    DrawTextEx(game->gameFont, player2Label, player2LabelPos, 24, 1, game->aiPaddle.color);
+    TextCacheDraw(UiFont(24), player2Label, player2LabelPos, 24, 1, game->opponentColor);
     
+    ProfileDraws(game, PROFILE_HUD);
     EndMode2D(); // End the camera mode with shake
     
     // UI elements that shouldn't shake (scores, messages)
@@ -962,58 +1685,90 @@ void DrawGame(Game *game) {
         
         // Draw pause message with glow effect
         Vector2 pauseTextPos = {
-            SCREEN_WIDTH/2 - MeasureTextEx(game->gameFont, pauseText, 60, 1).x/2,
+            SCREEN_WIDTH/2 - TextCacheMeasure(UiFont(60), pauseText, 60, 1).x/2,
             SCREEN_HEIGHT/2 - 60
         };
         
         Vector2 glowPos = { pauseTextPos.x + 2, pauseTextPos.y + 2 };
-        DrawTextEx(game->gameFont, pauseText, glowPos, 60, 1, ColorAlpha(COLOR_ACCENT, 0.5f));
-        DrawTextEx(game->gameFont, pauseText, pauseTextPos, 60, 1, WHITE);
+        TextCacheDraw(UiFont(60), pauseText, glowPos, 60, 1, ColorAlpha(COLOR_ACCENT, 0.5f));
+        TextCacheDraw(UiFont(60), pauseText, pauseTextPos, 60, 1, WHITE);
         
         Vector2 resumeTextPos = {
-            SCREEN_WIDTH/2 - MeasureTextEx(game->gameFont, resumeText, 24, 1).x/2,
+            SCREEN_WIDTH/2 - TextCacheMeasure(UiFont(24), resumeText, 24, 1).x/2,
             SCREEN_HEIGHT/2 + 30
         };
-        DrawTextEx(game->gameFont, resumeText, resumeTextPos, 24, 1, COLOR_ACCENT);
+        TextCacheDraw(UiFont(24), resumeText, resumeTextPos, 24, 1, COLOR_ACCENT);
         
         Vector2 copyrightPos = {
-            SCREEN_WIDTH/2 - MeasureTextEx(game->gameFont, copyrightText, 20, 1).x/2,
+            SCREEN_WIDTH/2 - TextCacheMeasure(UiFont(20), copyrightText, 20, 1).x/2,
             SCREEN_HEIGHT - 40
         };
-        DrawTextEx(game->gameFont, copyrightText, copyrightPos, 20, 1, ColorAlpha(WHITE, 0.7f));
+        TextCacheDraw(UiFont(20), copyrightText, copyrightPos, 20, 1, ColorAlpha(WHITE, 0.7f));
+        
+    } else if (game->state == STATE_CONNECTING ||
+               (game->net != NULL && game->net->status != NET_STATUS_RUNNING)) {
+        DrawRectangle(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, ColorAlpha(BLACK, 0.7f));
+        
+        bool waiting = (game->state == STATE_CONNECTING);
+        const char* netText = waiting ? "WAITING FOR OPPONENT" : "CONNECTION LOST";
+        const char* hintText = waiting ?
+                               (game->net->isHost ? "Hosting - waiting for a player to join" : "Connecting to host...") :
+                               "Press M for menu";
+        
+        Vector2 netTextPos = {
+            SCREEN_WIDTH/2 - TextCacheMeasure(UiFont(60), netText, 60, 1).x/2,
+            SCREEN_HEIGHT/2 - 60
+        };
+        Vector2 glowPos = { netTextPos.x + 2, netTextPos.y + 2 };
+        TextCacheDraw(UiFont(60), netText, glowPos, 60, 1, ColorAlpha(COLOR_ACCENT, 0.5f));
+        TextCacheDraw(UiFont(60), netText, netTextPos, 60, 1, WHITE);
+        
+        Vector2 hintTextPos = {
+            SCREEN_WIDTH/2 - TextCacheMeasure(UiFont(24), hintText, 24, 1).x/2,
+            SCREEN_HEIGHT/2 + 30
+        };
+        TextCacheDraw(UiFont(24), hintText, hintTextPos, 24, 1, COLOR_ACCENT);
         
     } else if (game->state == STATE_GAME_OVER) {
         // Draw semi-transparent overlay
         DrawRectangle(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, ColorAlpha(BLACK, 0.7f));
         
-        const char* winnerLabel = (game->playerScore >= game->winScore) ? 
+        bool leftWon = (game->sim.scores[SIM_SIDE_LEFT] >= game->sim.winScore);
+        const char* winnerLabel = leftWon ? 
                                 (game->mode == MODE_AI ? "YOU WIN!" : "PLAYER 1 WINS!") : 
                                 (game->mode == MODE_AI ? "AI WINS!" : "PLAYER 2 WINS!");
+        if (game->mode == MODE_ONLINE) {
+            bool localWon = leftWon == (game->net->localSide == SIM_SIDE_LEFT);
+            winnerLabel = localWon ? "YOU WIN!" : "YOU LOSE!";
+        }
         
+        // Online rematches need both players, so only offer the menu
         char restartText[] = "Press R to restart";
         char menuText[] = "Press M for menu";
         
         // Draw winner message with glow effect
         Vector2 winnerTextPos = {
-            SCREEN_WIDTH/2 - MeasureTextEx(game->gameFont, winnerLabel, 70, 1).x/2,
+            SCREEN_WIDTH/2 - TextCacheMeasure(UiFont(70), winnerLabel, 70, 1).x/2,
             SCREEN_HEIGHT/2 - 80
         };
         
         Vector2 glowPos = { winnerTextPos.x + 3, winnerTextPos.y + 3 };
-        DrawTextEx(game->gameFont, winnerLabel, glowPos, 70, 1, ColorAlpha(COLOR_ACCENT, 0.6f));
-        DrawTextEx(game->gameFont, winnerLabel, winnerTextPos, 70, 1, WHITE);
+        TextCacheDraw(UiFont(70), winnerLabel, glowPos, 70, 1, ColorAlpha(COLOR_ACCENT, 0.6f));
+        TextCacheDraw(UiFont(70), winnerLabel, winnerTextPos, 70, 1, WHITE);
         
         Vector2 restartTextPos = {
-            SCREEN_WIDTH/2 - MeasureTextEx(game->gameFont, restartText, 24, 1).x/2,
+            SCREEN_WIDTH/2 - TextCacheMeasure(UiFont(24), restartText, 24, 1).x/2,
             SCREEN_HEIGHT/2 + 20
         };
-        DrawTextEx(game->gameFont, restartText, restartTextPos, 24, 1, COLOR_ACCENT);
+        if (game->mode != MODE_ONLINE) {
+            TextCacheDraw(UiFont(24), restartText, restartTextPos, 24, 1, COLOR_ACCENT);
+        }
         
         Vector2 menuTextPos = {
-            SCREEN_WIDTH/2 - MeasureTextEx(game->gameFont, menuText, 24, 1).x/2,
+            SCREEN_WIDTH/2 - TextCacheMeasure(UiFont(24), menuText, 24, 1).x/2,
             SCREEN_HEIGHT/2 + 60
         };
-        DrawTextEx(game->gameFont, menuText, menuTextPos, 24, 1, COLOR_ACCENT);
+        TextCacheDraw(UiFont(24), menuText, menuTextPos, 24, 1, COLOR_ACCENT);
     }
     
     // Always show fullscreen toggle hint with subtle styling
@@ -1021,188 +1776,185 @@ void DrawGame(Game *game) {
     Vector2 fsTextPos = {20, SCREEN_HEIGHT - 35};
     DrawRectangleRounded(
         (Rectangle){ fsTextPos.x - 10, fsTextPos.y - 5, 
-                    MeasureTextEx(game->gameFont, fsText, 20, 1).x + 20, 30 },
+                    TextCacheMeasure(UiFont(20), fsText, 20, 1).x + 20, 30 },
         0.3f,
         6,
         ColorAlpha(BLACK, 0.5f)
     );
-    DrawTextEx(game->gameFont, fsText, fsTextPos, 20, 1, ColorAlpha(WHITE, 0.8f));
+    TextCacheDraw(UiFont(20), fsText, fsTextPos, 20, 1, ColorAlpha(WHITE, 0.8f));
+    
+    // Replay position and seek hint (changes every second, so not worth caching)
+    if (game->playingBack) {
+        int elapsed = (int)(game->sim.frame / SIM_TICK_RATE);
+        int total = (int)(game->playback.totalFrames / SIM_TICK_RATE);
+        char replayText[64];
+        sprintf(replayText, "REPLAY %02d:%02d / %02d:%02d   LEFT/RIGHT: Seek",
+                elapsed / 60, elapsed % 60, total / 60, total % 60);
+        Vector2 replayTextPos = {
+            SCREEN_WIDTH - MeasureTextEx(UiFont(20), replayText, 20, 1).x - 20,
+            SCREEN_HEIGHT - 35
+        };
+        DrawRectangleRounded(
+            (Rectangle){ replayTextPos.x - 10, replayTextPos.y - 5,
+                        MeasureTextEx(UiFont(20), replayText, 20, 1).x + 20, 30 },
+            0.3f,
+            6,
+            ColorAlpha(BLACK, 0.5f)
+        );
+        DrawTextEx(UiFont(20), replayText, replayTextPos, 20, 1, ColorAlpha(COLOR_ACCENT, 0.9f));
+    }
     
-    EndDrawing();
-}
-
-// Function to create particles
-void CreateParticleEffect(Game *game, Vector2 position, Color color, int count) {
-    for (int i = 0; i < count && game->activeParticles < MAX_PARTICLES; i++) {
-        int particleIndex = game->activeParticles;
-        game->particles[particleIndex].position = position;
-        game->particles[particleIndex].velocity = (Vector2){
-            (float)GetRandomValue(-200, 200) / 100.0f,
-            (float)GetRandomValue(-200, 200) / 100.0f
+    // Online link health: how often predictions were wrong and how far we rolled back
+    if (game->net != NULL && game->state != STATE_CONNECTING) {
+        char netText[96];
+        sprintf(netText, "ONLINE   rollbacks %u   resimulated %u   stalls %u",
+                game->net->rollbacks, game->net->resimulatedFrames, game->net->stalls);
+        Vector2 netTextPos = {
+            SCREEN_WIDTH - MeasureTextEx(UiFont(20), netText, 20, 1).x - 20,
+            SCREEN_HEIGHT - 35
         };
-        game->particles[particleIndex].lifeTime = 0;
-        game->particles[particleIndex].maxLifeTime = (float)GetRandomValue(30, 90) / 100.0f;
-        game->particles[particleIndex].color = color;
-        game->particles[particleIndex].size = (float)GetRandomValue(2, 6);
-        game->activeParticles++;
+        DrawRectangleRounded(
+            (Rectangle){ netTextPos.x - 10, netTextPos.y - 5,
+                        MeasureTextEx(UiFont(20), netText, 20, 1).x + 20, 30 },
+            0.3f,
+            6,
+            ColorAlpha(BLACK, 0.5f)
+        );
+        DrawTextEx(UiFont(20), netText, netTextPos, 20, 1, ColorAlpha(COLOR_ACCENT, 0.9f));
     }
-}
-
-// Function to update and draw particles
-void UpdateAndDrawParticles(Game *game) {
-    float deltaTime = GetFrameTime();
-    int particlesToKeep = 0;
+    ProfileDraws(game, PROFILE_HUD);
+    ProfilerEnd(&game->profiler, PROFILE_HUD);
     
-    for (int i = 0; i < game->activeParticles; i++) {
-        Particle *p = &game->particles[i];
-        
-        // Update particle
-        p->lifeTime += deltaTime;
-        
-        if (p->lifeTime >= p->maxLifeTime) {
-            continue; // Skip dead particles
-        }
-        
-        // Update position
-        p->position.x += p->velocity.x;
-        p->position.y += p->velocity.y;
-        
-        // Apply fade based on lifetime
-        float alpha = 1.0f - (p->lifeTime / p->maxLifeTime);
-        Color fadeColor = ColorAlpha(p->color, alpha);
-        
-        // Draw particle
-        DrawCircleV(p->position, p->size * alpha, fadeColor);
-        
-        // Keep this particle for next frame
-        if (i != particlesToKeep) {
-            game->particles[particlesToKeep] = *p;
-        }
-        particlesToKeep++;
+    // Drawn after the HUD is counted so the overlay doesn't measure itself
+    if (game->profiler.enabled && !game->benchmark) {
+        DrawProfilerOverlay(game);
+    }
+    if (game->measuringLatency) {
+        LatencyDrawMarker(playerRect.y);
+        game->latencyMarker = LatencyReadMarker();
+    }
+    if (game->benchmark) {
+        EndTextureMode();
     }
     
-    game->activeParticles = particlesToKeep;
+    ProfilerBegin(&game->profiler, PROFILE_PRESENT);
+    EndDrawing();
+    ProfilerEnd(&game->profiler, PROFILE_PRESENT);
 }
 
-// CheckPaddleCollision to create particles on collision
-bool CheckPaddleCollision(Ball *ball, Paddle *paddle, Game *game) {
-    // A slightly larger rectangle for better collision detection
-    Rectangle paddleRect = paddle->rect;
-    paddleRect.x -= ball->radius;
-    paddleRect.width += ball->radius * 2;
-    
-    // Only check collision if ball is moving toward paddle
-    bool movingTowardPaddle = (paddleRect.x < SCREEN_WIDTH/2 && ball->velocity.x < 0) || 
-                              (paddleRect.x > SCREEN_WIDTH/2 && ball->velocity.x > 0);
-                              
-    if (!movingTowardPaddle) return false;
-    
-    // Improved collision detection using ray-rectangle intersection
-    Vector2 ballPrev = {
-        ball->position.x - ball->velocity.x,
-        ball->position.y - ball->velocity.y
-    };
-    
-    Vector2 ballDir = {
-        ball->position.x - ballPrev.x,
-        ball->position.y - ballPrev.y
-    };
+void ProfileDraws(Game *game, ProfileStage stage) {
+    // Flushing splits the batch, so leave it alone unless someone is looking
+    if (!game->profiler.enabled) return;
     
-    float rayLength = sqrtf(ballDir.x * ballDir.x + ballDir.y * ballDir.y);
+    int drawCalls, vertices;
+    RenderStatsFlush(&drawCalls, &vertices);
+    ProfilerAddDraws(&game->profiler, stage, drawCalls, vertices);
+}
+
+void ToggleProfiler(Game *game) {
+    bool enable = !game->profiler.enabled;
     
-    if (rayLength > 0) {
-        ballDir.x /= rayLength;
-        ballDir.y /= rayLength;
-        
-        // Extended hit box for smoother collisions
-        Rectangle hitBox = {
-            paddleRect.x - ball->radius,
-            paddleRect.y - ball->radius,
-            paddleRect.width + ball->radius * 2,
-            paddleRect.height + ball->radius * 2
-        };
-        
-        // Check if ray intersects with paddle hit box
-        if (CheckCollisionPointRec(ball->position, hitBox) ||
-            CheckCollisionCircleRec(ball->position, ball->radius, paddleRect)) {
-            return true;
-        }
+    // The counting batch goes in the first time the overlay is opened
+    if (enable && !RenderStatsInit()) {
+        TraceLog(LOG_WARNING, "Could not create the render stats batch, draw counts will read 0");
     }
-    
-    // Fallback to simpler collision check
-    return CheckCollisionCircleRec(ball->position, ball->radius, paddleRect);
+    ProfilerSetEnabled(&game->profiler, enable);
 }
 
-void UpdateAI(Paddle *aiPaddle, Ball *ball, Game *game) {
-    // Extract difficulty from game parameters - base difficulty is still 0.7
-    // Higher ball speed means AI needs better accuracy
-    float difficulty = 0.7f * (1.0f + (game->ballSpeedMultiplier - 1.0f) * 0.5f);
-    difficulty = Clamp(difficulty, 0.5f, 0.95f); // Keep AI challenge balanced
-    
-    
-    // Calculate the predicted y-position where the ball will intersect with AI paddle
-    float predictedY = ball->position.y;
-    
-    // Only do advanced prediction when ball is moving toward the AI paddle
-    if (ball->velocity.x > 0) {
-        // Calculate time until ball reaches paddle (x distance / x speed)
-        float distanceToIntercept = aiPaddle->rect.x - ball->position.x;
-        float timeToIntercept = distanceToIntercept / ball->velocity.x;
-        
-        if (timeToIntercept > 0) {
-            // Predict where the ball will be at that time
-            predictedY = ball->position.y + (ball->velocity.y * timeToIntercept);
-            
-            // Account for possible bounces off top/bottom walls
-            float bounceDistance = predictedY < 0 ? -predictedY : 
-                                 (predictedY > SCREEN_HEIGHT ? 2*SCREEN_HEIGHT - predictedY : 0);
-            
-            while (bounceDistance > 0) {
-                if (predictedY < 0) {
-                    predictedY = -predictedY; // Bounce off top
-                } else if (predictedY > SCREEN_HEIGHT) {
-                    predictedY = 2*SCREEN_HEIGHT - predictedY; // Bounce off bottom
-                } else {
-                    break;
-                }
-                
-                // Check if another bounce would occur
-                bounceDistance = predictedY < 0 ? -predictedY : 
-                               (predictedY > SCREEN_HEIGHT ? 2*SCREEN_HEIGHT - predictedY : 0);
-            }
-        }
+void ToggleTrace(Game *game) {
+    // A second press ends the capture early
+    if (TraceCapturing()) {
+        TraceStop();
+        TraceLog(LOG_INFO, "Trace written to %s", game->tracePath);
+    } else if (TraceStart(game->tracePath, game->traceSeconds)) {
+        TraceLog(LOG_INFO, "Tracing %.1f seconds to %s", game->traceSeconds, game->tracePath);
+    } else {
+        TraceLog(LOG_WARNING, "Could not write trace to %s", game->tracePath);
     }
-    
-    // Target position (center of paddle aligned with predicted ball position)
-    float targetY = predictedY - aiPaddle->rect.height/2;
-    
-    // Some imperfection based on difficulty
-    if (GetRandomValue(0, 100) < (int)(30 * (1.0f - difficulty))) {
-        targetY += GetRandomValue(-30, 30) * (1.0f - difficulty);
+}
+
+void DrawProfilerOverlay(Game *game) {
+    // Percentiles over the last few seconds; refreshed twice a second so they can be read
+    static float refreshTimer = 0;
+    refreshTimer -= CosmeticDeltaTime();
+    if (refreshTimer <= 0) {
+        ProfilerSummarize(&game->profiler);
+        refreshTimer = 0.5f;
     }
     
-    // Clamp target position to screen bounds
-    targetY = Clamp(targetY, 0, SCREEN_HEIGHT - aiPaddle->rect.height);
+    const float lineHeight = 22;
+    const float columns[] = { 0, 130, 200, 270, 340, 400 };
+    Rectangle panel = {
+        SCREEN_WIDTH / 2 - 240, 10,
+        480, lineHeight * (PROFILE_STAGE_COUNT + 2) + 16
+    };
+    DrawRectangleRounded(panel, 0.05f, 6, ColorAlpha(BLACK, 0.75f));
     
-    // Calculate distance to target
-    float distanceToTarget = targetY - aiPaddle->rect.y;
+    Vector2 origin = { panel.x + 12, panel.y + 8 };
+    const char *headers[] = { "stage (ms)", "p50", "p95", "p99", "draws", "verts" };
+    for (int c = 0; c < 6; c++) {
+        DrawTextEx(UiFont(20), headers[c], (Vector2){ origin.x + columns[c], origin.y }, 20, 1, COLOR_ACCENT);
+    }
     
-    // Apply smooth movement with easing
-    if (fabsf(distanceToTarget) > 1.0f) {
-        // Use a proportional approach with difficulty factor
-        float moveStep = distanceToTarget * 0.1f * difficulty;
+    for (int stage = 0; stage <= PROFILE_STAGE_COUNT; stage++) {
+        const ProfileSummary *summary = &game->profiler.summary[stage];
+        float y = origin.y + lineHeight * (stage + 1);
+        Color color = (stage == PROFILE_STAGE_COUNT) ? YELLOW : WHITE;
         
-        // Cap movement speed
-        float maxStep = aiPaddle->speed * difficulty;
-        if (fabsf(moveStep) > maxStep) {
-            moveStep = maxStep * (distanceToTarget > 0 ? 1.0f : -1.0f);
+        char cells[6][16];
+        snprintf(cells[0], sizeof(cells[0]), "%s", ProfilerStageName(stage));
+        snprintf(cells[1], sizeof(cells[1]), "%.2f", summary->p50);
+        snprintf(cells[2], sizeof(cells[2]), "%.2f", summary->p95);
+        snprintf(cells[3], sizeof(cells[3]), "%.2f", summary->p99);
+        snprintf(cells[4], sizeof(cells[4]), "%d", summary->drawCalls);
+        snprintf(cells[5], sizeof(cells[5]), "%d", summary->vertices);
+        for (int c = 0; c < 6; c++) {
+            DrawTextEx(UiFont(20), cells[c], (Vector2){ origin.x + columns[c], y }, 20, 1, color);
         }
-        
-        aiPaddle->rect.y += moveStep;
     }
-    
-    // Ensure paddle stays in bounds
-    aiPaddle->rect.y = Clamp(aiPaddle->rect.y, 0, SCREEN_HEIGHT - aiPaddle->rect.height);
+}
+
+// Function to create particles
+void CreateParticleEffect(Game *game, Vector2 position, Color color, int count) {
+    uint32_t packed;
+    memcpy(&packed, &color, sizeof(packed));
+    
+    for (int i = 0; i < count; i++) {
+        // Speeds were tuned as pixels per 60 FPS frame; the engine wants pixels per second
+        float vx = (float)RngRange(&game->cosmeticRng, -200, 200) / 100.0f * 60.0f;
+        float vy = (float)RngRange(&game->cosmeticRng, -200, 200) / 100.0f * 60.0f;
+        float lifetime = (float)RngRange(&game->cosmeticRng, 30, 90) / 100.0f;
+        float size = (float)RngRange(&game->cosmeticRng, 2, 6);
+        if (!ParticleSpawn(&game->particles, position.x, position.y, vx, vy, lifetime, size, packed)) break;
+    }
+}
+
+// Move and fade particles; runs every frame, paused or not, like before
+void UpdateParticles(Game *game) {
+    ParticleUpdate(&game->particles, CosmeticDeltaTime());
+}
+
+// How far this frame moves the game along: the real frame time, clamped so a
+// stall doesn't turn into a burst of catch-up ticks (fixed in benchmark runs)
+float FrameDeltaTime(void) {
+    if (fixedFrameTime > 0.0f) return fixedFrameTime;
+    return fminf(GetFrameTime(), MAX_FRAME_TIME);
+}
+
+// Frame time for cosmetic animation, clamped like the sim's so a hitch doesn't
+// fling effects across the screen
+float CosmeticDeltaTime(void) {
+    return FrameDeltaTime();
+}
+
+// Frame-rate independent version of "value *= perFrameFactor" at 60 FPS
+float CosmeticDecay(float perFrameFactor, float dt) {
+    return powf(perFrameFactor, dt * COSMETIC_TUNED_FPS);
+}
+
+// Sharpest baked font for drawing at fontSize
+Font UiFont(float fontSize) {
+    return FontSetPick(&uiFonts, fontSize);
 }
 
 // Draw a rounded rectangle with glow effect
@@ -1238,27 +1990,18 @@ void DrawBallWithGlow(Vector2 center, float radius, Color color) {
     );
 }
 
-void ResetBall(Game *game, bool serverIsPlayer) {
-    // Reset ball position to center
-    game->ball.position = (Vector2){ SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2 };
-    
-    // Set initial velocity based on server
-    float initialSpeed = BALL_INITIAL_SPEED * game->ballSpeedMultiplier;
-    game->ball.velocity = (Vector2){
-        serverIsPlayer ? initialSpeed : -initialSpeed,
-        (float)GetRandomValue(-100, 100) / 100.0f * initialSpeed
-    };
-    
+// Cosmetic side of a serve; the sim has already re-centred the ball
+void ServeEffects(Game *game, bool serverIsPlayer) {
     // Update last score time for animation
     game->lastScoreTime = GetTime();
     game->scoreAnimScale = 1.5f; // Start animation scale
     
     // Add particles effect on scoring
-    Color particleColor = serverIsPlayer ? game->aiPaddle.color : game->playerPaddle.color;
+    Color particleColor = serverIsPlayer ? game->opponentColor : game->playerColor;
     CreateParticleEffect(
         game, 
-        game->ball.position,
+        (Vector2){ game->sim.ball.position.x, game->sim.ball.position.y },
         particleColor,
         30
     );
-}
\ No newline at end of file
+}
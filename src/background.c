@@ -0,0 +1,62 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2025, BISMAYA JYOTI DALEI
+
+See the LICENSE file in the project root for the full license text.
+*/
+
+#include "background.h"
+#include "gradient.h"
+
+static struct {
+    Texture2D texture;
+    int rows;
+    Color top;
+    Color bottom;
+} cache;
+
+static bool SameColor(Color a, Color b) {
+    return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+}
+
+static void BackgroundBuild(Color top, Color bottom, int rows) {
+    BackgroundUnload();
+
+    Image image = GenImageColor(1, rows, bottom);
+    GradientFillRows(&top.r, &bottom.r, (unsigned char *)image.data, rows);
+
+    cache.texture = LoadTextureFromImage(image);
+    UnloadImage(image);
+
+    // Smooth if the window is scaled, and never wrap the top row into the bottom
+    SetTextureFilter(cache.texture, TEXTURE_FILTER_BILINEAR);
+    SetTextureWrap(cache.texture, TEXTURE_WRAP_CLAMP);
+
+    cache.rows = rows;
+    cache.top = top;
+    cache.bottom = bottom;
+}
+
+void BackgroundDraw(Color top, Color bottom, int width, int height) {
+    // One texel per physical pixel row, whatever the window size
+    int rows = GetRenderHeight();
+    if (rows <= 0) rows = height;
+
+    if (cache.texture.id == 0 || cache.rows != rows ||
+        !SameColor(cache.top, top) || !SameColor(cache.bottom, bottom)) {
+        BackgroundBuild(top, bottom, rows);
+    }
+
+    DrawTexturePro(cache.texture,
+                   (Rectangle){ 0, 0, 1, (float)cache.rows },
+                   (Rectangle){ 0, 0, (float)width, (float)height },
+                   (Vector2){ 0, 0 }, 0.0f, WHITE);
+}
+
+void BackgroundUnload(void) {
+    if (cache.texture.id != 0) {
+        UnloadTexture(cache.texture);
+        cache.texture = (Texture2D){ 0 };
+    }
+}
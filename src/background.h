@@ -0,0 +1,27 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2025, BISMAYA JYOTI DALEI
+
+See the LICENSE file in the project root for the full license text.
+*/
+
+// Vertical gradient background shared by every screen.
+//
+// The gradient is baked once into a one-pixel-wide texture with a row per
+// rendered pixel and stretched over the screen as a single quad, instead of
+// one DrawLine per row every frame. It is rebuilt only when the render height
+// or the colors change (window resize, fullscreen toggle).
+
+#ifndef PONG_BACKGROUND_H
+#define PONG_BACKGROUND_H
+
+#include "../include/raylib.h"
+
+// Fill the width x height area at the origin with a gradient from top to bottom
+void BackgroundDraw(Color top, Color bottom, int width, int height);
+
+// Free the cached texture (call before CloseWindow)
+void BackgroundUnload(void);
+
+#endif // PONG_BACKGROUND_H
@@ -0,0 +1,116 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2025, BISMAYA JYOTI DALEI
+
+See the LICENSE file in the project root for the full license text.
+*/
+
+#include "court.h"
+#include "background.h"
+#include <math.h>
+
+static struct {
+    RenderTexture2D target;
+    bool valid;
+    Color top;
+    Color bottom;
+} court;
+
+static bool SameColor(Color a, Color b) {
+    return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+}
+
+// Everything on the court that never moves, in width x height coordinates
+static void DrawCourtLines(int width, int height) {
+    BackgroundDraw(court.top, court.bottom, width, height);
+
+    // Draw court lines and center circle
+    DrawLineEx(
+        (Vector2){ width/2, 0 },
+        (Vector2){ width/2, height },
+        2,
+        ColorAlpha(WHITE, 0.3f)
+    );
+
+    DrawCircleLines(width/2, height/2, 100, ColorAlpha(WHITE, 0.3f));
+
+    // Draw middle dashed line with smoother appearance
+    for (int i = 0; i < height; i += 20) {
+        DrawRectangleRounded(
+            (Rectangle){ width/2 - 1, i, 2, 10 },
+            0.5f,
+            4,
+            ColorAlpha(WHITE, 0.5f)
+        );
+    }
+}
+
+void CourtPrepare(Color top, Color bottom, int width, int height) {
+    // Match the physical resolution so the layer stays sharp when scaled,
+    // keeping the court's aspect ratio so the whole court fits when the
+    // render size has a different shape (the smaller of the two ratios)
+    float scale = 1.0f;
+    if (GetRenderWidth() > 0 && GetRenderHeight() > 0) {
+        scale = fminf((float)GetRenderWidth() / width, (float)GetRenderHeight() / height);
+    }
+    int targetWidth = (int)lroundf(width * scale);
+    int targetHeight = (int)lroundf(height * scale);
+
+    bool sizeChanged = court.target.id == 0 ||
+                       court.target.texture.width != targetWidth ||
+                       court.target.texture.height != targetHeight;
+    if (court.valid && !sizeChanged && SameColor(court.top, top) && SameColor(court.bottom, bottom)) return;
+
+    if (sizeChanged) {
+        CourtUnload();
+        court.target = LoadRenderTexture(targetWidth, targetHeight);
+        SetTextureFilter(court.target.texture, TEXTURE_FILTER_BILINEAR);
+    }
+    court.top = top;
+    court.bottom = bottom;
+
+    BeginTextureMode(court.target);
+    ClearBackground(BLANK);
+    BeginMode2D((Camera2D){
+        .offset = (Vector2){ 0, 0 },
+        .target = (Vector2){ 0, 0 },
+        .rotation = 0,
+        .zoom = scale
+    });
+    DrawCourtLines(width, height);
+    EndMode2D();
+
+    // Translucent lines leave the target's alpha below 1 (alpha gets blended
+    // too). Adding an opaque black rectangle saturates alpha without touching
+    // the colors, so the layer blits exactly as if drawn to the screen.
+    BeginBlendMode(BLEND_ADDITIVE);
+    DrawRectangle(0, 0, targetWidth, targetHeight, BLACK);
+    EndBlendMode();
+    EndTextureMode();
+
+    court.valid = true;
+}
+
+void CourtDraw(int width, int height) {
+    if (court.target.id == 0) return;
+
+    // Render textures are stored upside down
+    Texture2D texture = court.target.texture;
+    DrawTexturePro(texture,
+                   (Rectangle){ 0, 0, (float)texture.width, (float)-texture.height },
+                   (Rectangle){ 0, 0, (float)width, (float)height },
+                   (Vector2){ 0, 0 }, 0.0f, WHITE);
+}
+
+void CourtInvalidate(void) {
+    court.valid = false;
+}
+
+void CourtUnload(void) {
+    if (court.target.id != 0) {
+        UnloadRenderTexture(court.target);
+        court.target = (RenderTexture2D){ 0 };
+    }
+    court.valid = false;
+}
@@ -0,0 +1,31 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2025, BISMAYA JYOTI DALEI
+
+See the LICENSE file in the project root for the full license text.
+*/
+
+// Static court layer: background gradient, center line, center circle and
+// dashes, rendered once into a RenderTexture and blitted as a single quad.
+// Paddles, ball and particles are drawn on top every frame. The layer is
+// re-rendered only after CourtInvalidate or when the render size changes.
+
+#ifndef PONG_COURT_H
+#define PONG_COURT_H
+
+#include "../include/raylib.h"
+
+// Render the layer if it is missing or stale. Texture rendering resets the
+// camera, so call this before BeginDrawing rather than inside BeginMode2D.
+void CourtPrepare(Color top, Color bottom, int width, int height);
+
+// Draw the cached layer over the width x height area at the origin
+void CourtDraw(int width, int height);
+
+// Force a re-render on the next CourtPrepare (fullscreen toggle)
+void CourtInvalidate(void);
+
+void CourtUnload(void);
+
+#endif // PONG_COURT_H
@@ -0,0 +1,258 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2025, BISMAYA JYOTI DALEI
+
+See the LICENSE file in the project root for the full license text.
+*/
+
+#include "fontcache.h"
+#include "mapfile.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#define FONT_GLYPH_COUNT 95        // Printable ASCII, same as LoadFontEx's default
+#define FONT_GLYPH_PADDING 4       // Same as LoadFontEx
+#define FONT_CACHE_ENDIAN_CHECK 0x01020304u
+
+// File layout: header, one entry per size, then 8-byte aligned blobs
+// (glyph rectangles, glyph metrics, atlas pixels) referenced by offset.
+typedef struct {
+    char magic[4];
+    uint32_t version;
+    uint32_t endianCheck;
+    uint32_t fontCount;
+    int64_t sourceModTime;
+    int64_t sourceSize;
+    int32_t sizes[FONT_SET_MAX_SIZES];
+} FontCacheHeader;
+
+typedef struct {
+    int32_t value;
+    int32_t offsetX;
+    int32_t offsetY;
+    int32_t advanceX;
+} FontCacheGlyph;
+
+typedef struct {
+    int32_t baseSize;
+    int32_t glyphCount;
+    int32_t glyphPadding;
+    int32_t atlasWidth;
+    int32_t atlasHeight;
+    int32_t atlasFormat;
+    uint64_t recsOffset;
+    uint64_t glyphsOffset;
+    uint64_t atlasOffset;
+    uint64_t atlasBytes;
+} FontCacheEntry;
+
+static FontCacheHeader MakeHeader(const char *ttfPath, const int *sizes, int count) {
+    FontCacheHeader header = { 0 };
+    memcpy(header.magic, FONT_CACHE_MAGIC, 4);
+    header.version = FONT_CACHE_VERSION;
+    header.endianCheck = FONT_CACHE_ENDIAN_CHECK;
+    header.fontCount = (uint32_t)count;
+    header.sourceModTime = GetFileModTime(ttfPath);
+    header.sourceSize = GetFileLength(ttfPath);
+    for (int i = 0; i < count; i++) header.sizes[i] = sizes[i];
+    return header;
+}
+
+static bool InRange(const MappedFile *file, uint64_t offset, uint64_t bytes) {
+    return offset <= file->size && bytes <= file->size - offset;
+}
+
+// Upload every atlas straight from the mapping. Returns false (having loaded
+// nothing) if the file is stale or malformed.
+static bool LoadFromCache(FontSet *set, const char *cachePath, const FontCacheHeader *expected) {
+    MappedFile file;
+    if (!MapFileOpen(&file, cachePath)) return false;
+
+    size_t tableSize = sizeof(FontCacheHeader) + expected->fontCount * sizeof(FontCacheEntry);
+    if (file.size < tableSize || memcmp(file.data, expected, sizeof(FontCacheHeader)) != 0) {
+        MapFileClose(&file);
+        return false;
+    }
+
+    // Validate everything before creating any GPU resources
+    const FontCacheEntry *entries = (const FontCacheEntry *)(file.data + sizeof(FontCacheHeader));
+    for (uint32_t i = 0; i < expected->fontCount; i++) {
+        const FontCacheEntry *e = &entries[i];
+        bool valid = e->glyphCount > 0 && e->atlasWidth > 0 && e->atlasHeight > 0 &&
+                     e->atlasBytes == (uint64_t)GetPixelDataSize(e->atlasWidth, e->atlasHeight, e->atlasFormat) &&
+                     InRange(&file, e->recsOffset, (uint64_t)e->glyphCount * sizeof(Rectangle)) &&
+                     InRange(&file, e->glyphsOffset, (uint64_t)e->glyphCount * sizeof(FontCacheGlyph)) &&
+                     InRange(&file, e->atlasOffset, e->atlasBytes);
+        if (!valid) {
+            MapFileClose(&file);
+            return false;
+        }
+    }
+
+    for (uint32_t i = 0; i < expected->fontCount; i++) {
+        const FontCacheEntry *e = &entries[i];
+        Font font = { 0 };
+        font.baseSize = e->baseSize;
+        font.glyphCount = e->glyphCount;
+        font.glyphPadding = e->glyphPadding;
+
+        // raylib's allocator, so UnloadFont can free these as usual
+        font.recs = MemAlloc((unsigned int)(e->glyphCount * sizeof(Rectangle)));
+        font.glyphs = MemAlloc((unsigned int)(e->glyphCount * sizeof(GlyphInfo)));
+        memcpy(font.recs, file.data + e->recsOffset, (size_t)e->glyphCount * sizeof(Rectangle));
+        const FontCacheGlyph *glyphs = (const FontCacheGlyph *)(file.data + e->glyphsOffset);
+        for (int g = 0; g < e->glyphCount; g++) {
+            font.glyphs[g].value = glyphs[g].value;
+            font.glyphs[g].offsetX = glyphs[g].offsetX;
+            font.glyphs[g].offsetY = glyphs[g].offsetY;
+            font.glyphs[g].advanceX = glyphs[g].advanceX;
+        }
+
+        // The pixels go to the GPU directly from the mapped pages
+        Image atlas = {
+            .data = (void *)(file.data + e->atlasOffset),
+            .width = e->atlasWidth,
+            .height = e->atlasHeight,
+            .mipmaps = 1,
+            .format = e->atlasFormat
+        };
+        font.texture = LoadTextureFromImage(atlas);
+        SetTextureFilter(font.texture, TEXTURE_FILTER_BILINEAR);
+
+        set->fonts[set->count++] = font;
+    }
+
+    MapFileClose(&file);
+    set->fromCache = true;
+    return true;
+}
+
+static void WriteBlob(FILE *out, const void *data, size_t size, uint64_t *offset) {
+    static const unsigned char zeros[8] = { 0 };
+    fwrite(data, 1, size, out);
+    *offset += size;
+    size_t pad = (size_t)((8 - (*offset & 7)) & 7);
+    fwrite(zeros, 1, pad, out);
+    *offset += pad;
+}
+
+// Best effort: a read-only install just bakes on every launch
+static void WriteCache(const char *cachePath, const FontCacheHeader *header, Font *fonts, Image *atlases, int count) {
+    FILE *out = fopen(cachePath, "wb");
+    if (out == NULL) return;
+
+    FontCacheEntry entries[FONT_SET_MAX_SIZES] = { 0 };
+    uint64_t offset = sizeof(FontCacheHeader) + (uint64_t)count * sizeof(FontCacheEntry);
+    offset = (offset + 7) & ~(uint64_t)7;
+
+    // Work out where every blob lands first so the table can be written up front
+    for (int i = 0; i < count; i++) {
+        FontCacheEntry *e = &entries[i];
+        e->baseSize = fonts[i].baseSize;
+        e->glyphCount = fonts[i].glyphCount;
+        e->glyphPadding = fonts[i].glyphPadding;
+        e->atlasWidth = atlases[i].width;
+        e->atlasHeight = atlases[i].height;
+        e->atlasFormat = atlases[i].format;
+        e->atlasBytes = (uint64_t)GetPixelDataSize(atlases[i].width, atlases[i].height, atlases[i].format);
+
+        e->recsOffset = offset;
+        offset = (offset + (uint64_t)e->glyphCount * sizeof(Rectangle) + 7) & ~(uint64_t)7;
+        e->glyphsOffset = offset;
+        offset = (offset + (uint64_t)e->glyphCount * sizeof(FontCacheGlyph) + 7) & ~(uint64_t)7;
+        e->atlasOffset = offset;
+        offset = (offset + e->atlasBytes + 7) & ~(uint64_t)7;
+    }
+
+    uint64_t written = 0;
+    fwrite(header, sizeof(*header), 1, out);
+    written += sizeof(*header);
+    WriteBlob(out, entries, (size_t)count * sizeof(FontCacheEntry), &written);
+
+    for (int i = 0; i < count; i++) {
+        WriteBlob(out, fonts[i].recs, (size_t)fonts[i].glyphCount * sizeof(Rectangle), &written);
+
+        FontCacheGlyph glyphs[FONT_GLYPH_COUNT];
+        for (int g = 0; g < fonts[i].glyphCount && g < FONT_GLYPH_COUNT; g++) {
+            glyphs[g] = (FontCacheGlyph){
+                fonts[i].glyphs[g].value, fonts[i].glyphs[g].offsetX,
+                fonts[i].glyphs[g].offsetY, fonts[i].glyphs[g].advanceX
+            };
+        }
+        WriteBlob(out, glyphs, (size_t)fonts[i].glyphCount * sizeof(FontCacheGlyph), &written);
+        WriteBlob(out, atlases[i].data, (size_t)entries[i].atlasBytes, &written);
+    }
+
+    bool ok = (ferror(out) == 0);
+    if (fclose(out) != 0) ok = false;
+    if (!ok) remove(cachePath);   // Never leave a truncated cache behind
+}
+
+// Rasterize every size the way LoadFontEx does, keeping the CPU-side atlas
+// images long enough to write the cache
+static bool Bake(FontSet *set, const char *ttfPath, const char *cachePath,
+                 const FontCacheHeader *header, const int *sizes, int count) {
+    int dataSize = 0;
+    unsigned char *fileData = LoadFileData(ttfPath, &dataSize);
+    if (fileData == NULL) return false;
+
+    Image atlases[FONT_SET_MAX_SIZES] = { 0 };
+    for (int i = 0; i < count; i++) {
+        Font font = { 0 };
+        font.baseSize = sizes[i];
+        font.glyphCount = FONT_GLYPH_COUNT;
+        font.glyphPadding = FONT_GLYPH_PADDING;
+        font.glyphs = LoadFontData(fileData, dataSize, sizes[i], NULL, FONT_GLYPH_COUNT, FONT_DEFAULT);
+        if (font.glyphs == NULL) break;
+
+        atlases[i] = GenImageFontAtlas(font.glyphs, &font.recs, font.glyphCount, sizes[i], FONT_GLYPH_PADDING, 0);
+        font.texture = LoadTextureFromImage(atlases[i]);
+        SetTextureFilter(font.texture, TEXTURE_FILTER_BILINEAR);
+
+        // Glyph bitmaps are only needed to build the atlas
+        for (int g = 0; g < font.glyphCount; g++) {
+            UnloadImage(font.glyphs[g].image);
+            font.glyphs[g].image = (Image){ 0 };
+        }
+        set->fonts[set->count++] = font;
+    }
+    UnloadFileData(fileData);
+
+    if (set->count == count) {
+        WriteCache(cachePath, header, set->fonts, atlases, count);
+    }
+    for (int i = 0; i < count; i++) UnloadImage(atlases[i]);
+    return set->count == count;
+}
+
+bool FontSetLoad(FontSet *set, const char *ttfPath, const char *cachePath, const int *sizes, int count) {
+    memset(set, 0, sizeof(*set));
+    if (count > FONT_SET_MAX_SIZES) count = FONT_SET_MAX_SIZES;
+
+    if (FileExists(ttfPath) && count > 0) {
+        FontCacheHeader header = MakeHeader(ttfPath, sizes, count);
+        if (LoadFromCache(set, cachePath, &header)) return true;
+        if (Bake(set, ttfPath, cachePath, &header, sizes, count)) return true;
+        FontSetUnload(set);
+    }
+
+    // Fall back to raylib's built-in font for every size
+    set->fonts[0] = GetFontDefault();
+    set->count = 1;
+    return false;
+}
+
+Font FontSetPick(const FontSet *set, float fontSize) {
+    for (int i = 0; i < set->count; i++) {
+        if (set->fonts[i].baseSize >= fontSize) return set->fonts[i];
+    }
+    return set->fonts[set->count > 0 ? set->count - 1 : 0];
+}
+
+void FontSetUnload(FontSet *set) {
+    // UnloadFont leaves raylib's default font alone
+    for (int i = 0; i < set->count; i++) UnloadFont(set->fonts[i]);
+    set->count = 0;
+}
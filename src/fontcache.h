@@ -0,0 +1,47 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2025, BISMAYA JYOTI DALEI
+
+See the LICENSE file in the project root for the full license text.
+*/
+
+// Pre-baked font atlases, one per UI text size.
+//
+// Text drawn far above a font's base size is upscaled from its atlas and
+// looks blurry, so the UI font is rasterized once for every size the game
+// draws at and each draw picks the closest atlas at or above its size.
+//
+// Rasterizing a TTF at eight sizes is the slowest part of startup, so the
+// baked atlases (pixels, glyph rectangles and metrics) are written to a cache
+// file. Later launches map that file and upload the atlases straight from the
+// mapping. The cache is rebuilt whenever the TTF's size or modification time,
+// the size list or the format changes. It is a machine-local file in native
+// byte order, not something to ship.
+
+#ifndef PONG_FONTCACHE_H
+#define PONG_FONTCACHE_H
+
+#include "../include/raylib.h"
+
+#define FONT_SET_MAX_SIZES 16
+#define FONT_CACHE_MAGIC "PPFC"
+#define FONT_CACHE_VERSION 1
+
+typedef struct {
+    Font fonts[FONT_SET_MAX_SIZES];   // Sorted by baseSize
+    int count;
+    bool fromCache;                   // Loaded from the cache file rather than baked
+} FontSet;
+
+// Load sizes[0..count) (ascending) of ttfPath, from cachePath when it is valid, otherwise
+// by baking and then writing cachePath. Falls back to raylib's default font
+// (and returns false) if the TTF can't be read.
+bool FontSetLoad(FontSet *set, const char *ttfPath, const char *cachePath, const int *sizes, int count);
+
+// Font to draw fontSize with: the smallest baked size >= fontSize, else the largest
+Font FontSetPick(const FontSet *set, float fontSize);
+
+void FontSetUnload(FontSet *set);
+
+#endif // PONG_FONTCACHE_H
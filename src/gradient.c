@@ -0,0 +1,19 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2025, BISMAYA JYOTI DALEI
+
+See the LICENSE file in the project root for the full license text.
+*/
+
+#include "gradient.h"
+
+void GradientFillRows(const unsigned char *top, const unsigned char *bottom, unsigned char *pixels, int rows) {
+    // Same per-row interpolation the screens used to do with DrawLine
+    for (int y = 0; y < rows; y++) {
+        float factor = (float)y / rows;
+        for (int c = 0; c < 4; c++) {
+            pixels[y * 4 + c] = (unsigned char)(top[c] + (bottom[c] - top[c]) * factor);
+        }
+    }
+}
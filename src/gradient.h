@@ -0,0 +1,20 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2025, BISMAYA JYOTI DALEI
+
+See the LICENSE file in the project root for the full license text.
+*/
+
+// Vertical gradient rows for the background texture. Split out of
+// background.c so the color math has no raylib dependency and can be
+// benchmarked headless.
+
+#ifndef PONG_GRADIENT_H
+#define PONG_GRADIENT_H
+
+// Fill rows RGBA pixels (4 bytes each) from top to bottom. top and bottom
+// are RGBA too, so a raylib Color can be passed as &color.r.
+void GradientFillRows(const unsigned char *top, const unsigned char *bottom, unsigned char *pixels, int rows);
+
+#endif // PONG_GRADIENT_H
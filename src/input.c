@@ -0,0 +1,232 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2025, BISMAYA JYOTI DALEI
+
+See the LICENSE file in the project root for the full license text.
+*/
+
+#include "input.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+bool InputQueuePush(InputQueue *queue, const InputEvent *event) {
+    unsigned head = atomic_load_explicit(&queue->head, memory_order_relaxed);
+    unsigned tail = atomic_load_explicit(&queue->tail, memory_order_acquire);
+    if (head - tail >= INPUT_QUEUE_EVENTS) {
+        atomic_fetch_add_explicit(&queue->dropped, 1, memory_order_relaxed);
+        return false;
+    }
+
+    queue->events[head & (INPUT_QUEUE_EVENTS - 1)] = *event;
+    atomic_store_explicit(&queue->head, head + 1, memory_order_release);
+    return true;
+}
+
+bool InputQueuePop(InputQueue *queue, uint64_t untilNs, InputEvent *event) {
+    unsigned tail = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+    unsigned head = atomic_load_explicit(&queue->head, memory_order_acquire);
+    if (tail == head) return false;
+
+    const InputEvent *next = &queue->events[tail & (INPUT_QUEUE_EVENTS - 1)];
+    if (next->timeNs > untilNs) return false;
+
+    *event = *next;
+    atomic_store_explicit(&queue->tail, tail + 1, memory_order_release);
+    return true;
+}
+
+static void SetButton(uint8_t *button, bool down) {
+    if (down && !(*button & INPUT_DOWN)) {
+        *button |= INPUT_DOWN | INPUT_PRESSED;
+    } else if (!down && (*button & INPUT_DOWN)) {
+        *button = (uint8_t)((*button & ~INPUT_DOWN) | INPUT_RELEASED);
+    }
+}
+
+void InputStateApply(InputState *state, const InputEvent *event) {
+    bool down = event->value != 0.0f;
+
+    switch (event->type) {
+        case INPUT_EVENT_KEY:
+            if (event->code < INPUT_KEY_COUNT) SetButton(&state->keys[event->code], down);
+            break;
+        case INPUT_EVENT_MOUSE_BUTTON:
+            if (event->code < INPUT_MOUSE_BUTTONS) SetButton(&state->mouseButtons[event->code], down);
+            break;
+        case INPUT_EVENT_MOUSE_MOVE:
+            state->mouseX = event->value;
+            state->mouseY = event->y;
+            break;
+        case INPUT_EVENT_GAMEPAD_BUTTON:
+            if (event->device < INPUT_MAX_GAMEPADS && event->code < INPUT_GAMEPAD_BUTTONS) {
+                SetButton(&state->gamepadButtons[event->device][event->code], down);
+            }
+            break;
+        case INPUT_EVENT_GAMEPAD_AXIS:
+            if (event->device < INPUT_MAX_GAMEPADS && event->code < INPUT_GAMEPAD_AXES) {
+                state->gamepadAxes[event->device][event->code] = event->value;
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+static void ClearEdges(uint8_t *buttons, int count) {
+    for (int i = 0; i < count; i++) buttons[i] &= INPUT_DOWN;
+}
+
+void InputStateClearEdges(InputState *state) {
+    ClearEdges(state->keys, INPUT_KEY_COUNT);
+    ClearEdges(state->mouseButtons, INPUT_MOUSE_BUTTONS);
+    ClearEdges(&state->gamepadButtons[0][0], INPUT_MAX_GAMEPADS * INPUT_GAMEPAD_BUTTONS);
+}
+
+void InputBeginFrame(InputSystem *input, uint64_t nowNs) {
+    InputStateClearEdges(&input->frame);
+    for (int i = 0; i < input->lateCount; i++) {
+        InputStateApply(&input->frame, &input->late[i]);
+    }
+    input->lateCount = 0;
+
+    InputEvent event;
+    while (input->pendingCount < INPUT_QUEUE_EVENTS && InputQueuePop(&input->queue, nowNs, &event)) {
+        InputStateApply(&input->frame, &event);
+        input->pending[input->pendingCount++] = event;
+    }
+    input->frameNs = nowNs;
+}
+
+void InputCollect(InputSystem *input, uint64_t nowNs) {
+    InputEvent event;
+    while (input->lateCount < INPUT_LATE_EVENTS && input->pendingCount < INPUT_QUEUE_EVENTS &&
+           InputQueuePop(&input->queue, nowNs, &event)) {
+        input->pending[input->pendingCount++] = event;
+        input->late[input->lateCount++] = event;
+    }
+}
+
+void InputBeginTick(InputSystem *input, uint64_t tickEndNs, uint64_t tickNs) {
+    InputState *tick = &input->tick;
+    InputStateClearEdges(tick);
+    if (tickNs == 0 || tickNs > tickEndNs) tickNs = 1;
+    uint64_t tickStartNs = tickEndNs - tickNs;
+
+    // Area under each curved axis since the start of the tick, and how far
+    // into the tick it has been summed
+    double area[INPUT_MAX_GAMEPADS][INPUT_GAMEPAD_AXES] = { { 0 } };
+    uint64_t summedTo[INPUT_MAX_GAMEPADS][INPUT_GAMEPAD_AXES];
+    for (int pad = 0; pad < INPUT_MAX_GAMEPADS; pad++) {
+        for (int axis = 0; axis < INPUT_GAMEPAD_AXES; axis++) summedTo[pad][axis] = tickStartNs;
+    }
+
+    int used = 0;
+    while (used < input->pendingCount && input->pending[used].timeNs <= tickEndNs) {
+        const InputEvent *event = &input->pending[used];
+        if (event->type == INPUT_EVENT_GAMEPAD_AXIS && event->device < INPUT_MAX_GAMEPADS &&
+            event->code < INPUT_GAMEPAD_AXES && event->timeNs > tickStartNs) {
+            int pad = event->device, axis = event->code;
+            float held = InputCurveApply(&input->curves[axis], tick->gamepadAxes[pad][axis]);
+            area[pad][axis] += held * (double)(event->timeNs - summedTo[pad][axis]);
+            summedTo[pad][axis] = event->timeNs;
+        }
+        InputStateApply(tick, event);
+        used++;
+    }
+    input->pendingCount -= used;
+
+    for (int pad = 0; pad < INPUT_MAX_GAMEPADS; pad++) {
+        for (int axis = 0; axis < INPUT_GAMEPAD_AXES; axis++) {
+            float held = InputCurveApply(&input->curves[axis], tick->gamepadAxes[pad][axis]);
+            area[pad][axis] += held * (double)(tickEndNs - summedTo[pad][axis]);
+            tick->gamepadAxisMeans[pad][axis] = (float)(area[pad][axis] / (double)tickNs);
+        }
+    }
+    memmove(input->pending, input->pending + used, sizeof(InputEvent) * (size_t)input->pendingCount);
+}
+
+void InputFlushTicks(InputSystem *input) {
+    for (int i = 0; i < input->pendingCount; i++) {
+        InputStateApply(&input->tick, &input->pending[i]);
+    }
+    input->pendingCount = 0;
+}
+
+void InputReset(InputSystem *input) {
+    InputEvent event;
+    while (InputQueuePop(&input->queue, UINT64_MAX, &event)) {}
+    atomic_store(&input->queue.dropped, 0);
+    memset(&input->frame, 0, sizeof(input->frame));
+    memset(&input->tick, 0, sizeof(input->tick));
+    input->pendingCount = 0;
+    input->lateCount = 0;
+}
+
+static uint8_t Button(const uint8_t *buttons, int count, int index) {
+    return (index >= 0 && index < count) ? buttons[index] : 0;
+}
+
+bool InputKeyDown(const InputState *state, int key) {
+    return Button(state->keys, INPUT_KEY_COUNT, key) & INPUT_DOWN;
+}
+
+bool InputKeyPressed(const InputState *state, int key) {
+    return Button(state->keys, INPUT_KEY_COUNT, key) & INPUT_PRESSED;
+}
+
+bool InputKeyActive(const InputState *state, int key) {
+    return Button(state->keys, INPUT_KEY_COUNT, key) & (INPUT_DOWN | INPUT_PRESSED);
+}
+
+bool InputMouseButtonDown(const InputState *state, int button) {
+    return Button(state->mouseButtons, INPUT_MOUSE_BUTTONS, button) & INPUT_DOWN;
+}
+
+bool InputMouseButtonPressed(const InputState *state, int button) {
+    return Button(state->mouseButtons, INPUT_MOUSE_BUTTONS, button) & INPUT_PRESSED;
+}
+
+bool InputGamepadButtonDown(const InputState *state, int gamepad, int button) {
+    if (gamepad < 0 || gamepad >= INPUT_MAX_GAMEPADS) return false;
+    return Button(state->gamepadButtons[gamepad], INPUT_GAMEPAD_BUTTONS, button) & INPUT_DOWN;
+}
+
+bool InputGamepadButtonPressed(const InputState *state, int gamepad, int button) {
+    if (gamepad < 0 || gamepad >= INPUT_MAX_GAMEPADS) return false;
+    return Button(state->gamepadButtons[gamepad], INPUT_GAMEPAD_BUTTONS, button) & INPUT_PRESSED;
+}
+
+float InputGamepadAxis(const InputState *state, int gamepad, int axis) {
+    if (gamepad < 0 || gamepad >= INPUT_MAX_GAMEPADS || axis < 0 || axis >= INPUT_GAMEPAD_AXES) return 0.0f;
+    return state->gamepadAxes[gamepad][axis];
+}
+
+float InputGamepadAxisMean(const InputState *state, int gamepad, int axis) {
+    if (gamepad < 0 || gamepad >= INPUT_MAX_GAMEPADS || axis < 0 || axis >= INPUT_GAMEPAD_AXES) return 0.0f;
+    return state->gamepadAxisMeans[gamepad][axis];
+}
+
+float InputCurveApply(const InputCurve *curve, float value) {
+    float magnitude = fabsf(value);
+    float saturation = (curve->saturation > 0.0f) ? curve->saturation : 1.0f;
+    float exponent = (curve->exponent > 0.0f) ? curve->exponent : 1.0f;
+    if (magnitude <= curve->deadzone) return 0.0f;
+    if (saturation <= curve->deadzone) return (value < 0.0f) ? -1.0f : 1.0f;
+
+    float scaled = fminf((magnitude - curve->deadzone) / (saturation - curve->deadzone), 1.0f);
+    if (exponent != 1.0f) scaled = powf(scaled, exponent);
+    return (value < 0.0f) ? -scaled : scaled;
+}
+
+bool InputCurveParse(const char *text, InputCurve *curve) {
+    InputCurve parsed = { 0.0f, 1.0f, 1.0f };
+    int fields = sscanf(text, "%f,%f,%f", &parsed.deadzone, &parsed.exponent, &parsed.saturation);
+    if (fields < 2 || parsed.deadzone < 0.0f || parsed.deadzone >= 1.0f || parsed.exponent <= 0.0f ||
+        parsed.saturation <= parsed.deadzone || parsed.saturation > 1.0f) {
+        return false;
+    }
+    *curve = parsed;
+    return true;
+}
@@ -0,0 +1,160 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2025, BISMAYA JYOTI DALEI
+
+See the LICENSE file in the project root for the full license text.
+*/
+
+// Timestamped input events, queued by their producers and consumed per frame
+// (menus, hotkeys) and per fixed sim tick (paddles).
+//
+// Producers stamp each key, mouse and gamepad event with TimerNowNs() and
+// push it into an InputQueue, a single-producer single-consumer ring with no
+// locks, so the producer can be the window's event callbacks on the main
+// thread or a thread of its own (synthetic or scripted input). Once per frame
+// InputBeginFrame drains everything that has happened into the frame view,
+// and each sim tick's InputBeginTick then applies just the events stamped up
+// to the end of that tick to the tick view. A key pressed late in a long
+// frame lands in the tick that covers it, and a tap shorter than a frame
+// still shows up as a press. Events past the last tick of a frame (every
+// event of a frame too short to run a tick) are held for the next frame's
+// ticks; only while no ticks run at all are they flushed with
+// InputFlushTicks.
+//
+// Gamepad axes go through a response curve per axis, and the tick view also
+// keeps each axis averaged over the tick's span of time: the stick is held at
+// each sampled value until the next sample, so a paddle driven by the average
+// moves exactly as far as it would have moving continuously at the speed the
+// stick asked for, wherever the samples fall inside the tick.
+//
+// Key and mouse button codes are raylib's (which are GLFW's). No raylib in
+// here; src/inputcapture.c feeds the queue from the window.
+
+#ifndef PONG_INPUT_H
+#define PONG_INPUT_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#define INPUT_QUEUE_EVENTS 512     // A power of two
+#define INPUT_LATE_EVENTS 64       // Taken mid-frame by InputCollect
+#define INPUT_KEY_COUNT 352        // Highest raylib key is KEY_KB_MENU (348)
+#define INPUT_MOUSE_BUTTONS 8
+#define INPUT_MAX_GAMEPADS 4
+#define INPUT_GAMEPAD_BUTTONS 32
+#define INPUT_GAMEPAD_AXES 8
+
+typedef enum {
+    INPUT_EVENT_KEY,
+    INPUT_EVENT_MOUSE_BUTTON,
+    INPUT_EVENT_MOUSE_MOVE,
+    INPUT_EVENT_GAMEPAD_BUTTON,
+    INPUT_EVENT_GAMEPAD_AXIS
+} InputEventType;
+
+typedef struct {
+    uint64_t timeNs;     // TimerNowNs() when it happened
+    uint8_t type;        // InputEventType
+    uint8_t device;      // Gamepad index
+    uint16_t code;       // Key, button or axis
+    float value;         // Buttons: 1 down, 0 up. Axes: position. Mouse: x
+    float y;             // Mouse only
+} InputEvent;
+
+// Maps a raw axis deflection to -1..1. The sign is kept and the curve is
+// applied to the magnitude. A zeroed curve passes values through unchanged.
+typedef struct {
+    float deadzone;          // Deflection up to this reads as 0
+    float saturation;        // Deflection from this on reads as full scale (0 for 1)
+    float exponent;          // 1 is linear, above 1 gives finer control near the center (0 for 1)
+} InputCurve;
+
+// Only one thread may push and only one may pop
+typedef struct {
+    InputEvent events[INPUT_QUEUE_EVENTS];
+    atomic_uint head;
+    atomic_uint tail;
+    atomic_uint dropped;     // Events pushed while the queue was full
+} InputQueue;
+
+// Button state bits
+#define INPUT_DOWN 1
+#define INPUT_PRESSED 2          // Went down since the last edge reset
+#define INPUT_RELEASED 4         // Went up since the last edge reset
+
+typedef struct {
+    uint8_t keys[INPUT_KEY_COUNT];
+    uint8_t mouseButtons[INPUT_MOUSE_BUTTONS];
+    uint8_t gamepadButtons[INPUT_MAX_GAMEPADS][INPUT_GAMEPAD_BUTTONS];
+    float gamepadAxes[INPUT_MAX_GAMEPADS][INPUT_GAMEPAD_AXES];        // Latest raw value
+    float gamepadAxisMeans[INPUT_MAX_GAMEPADS][INPUT_GAMEPAD_AXES];   // Curved, averaged over the tick (tick view only)
+    float mouseX;
+    float mouseY;
+} InputState;
+
+typedef struct {
+    InputQueue queue;
+    InputState frame;        // Every event up to the start of this frame
+    InputState tick;         // Events up to the end of the tick being simulated
+    uint64_t frameNs;        // When this frame's events were drained
+    InputCurve curves[INPUT_GAMEPAD_AXES];   // Per axis index, on every gamepad
+    // Drained from the queue but past the end of every tick run so far
+    InputEvent pending[INPUT_QUEUE_EVENTS];
+    int pendingCount;
+    // Taken by InputCollect after the frame started; the frame view gets
+    // them at the next InputBeginFrame
+    InputEvent late[INPUT_LATE_EVENTS];
+    int lateCount;
+} InputSystem;
+
+// False (and the event is counted as dropped) if the queue is full
+bool InputQueuePush(InputQueue *queue, const InputEvent *event);
+
+// Take the oldest event if it happened at or before untilNs
+bool InputQueuePop(InputQueue *queue, uint64_t untilNs, InputEvent *event);
+
+void InputStateApply(InputState *state, const InputEvent *event);
+void InputStateClearEdges(InputState *state);
+
+// Start a frame at nowNs: move every event queued up to then into the frame
+// view (edges start over) and hold them for the ticks, behind any events the
+// ticks of earlier frames didn't reach yet.
+void InputBeginFrame(InputSystem *input, uint64_t nowNs);
+
+// Hold everything queued up to nowNs for the ticks still to run this frame,
+// for devices polled again just before a tick. The frame view sees these
+// events from the next frame on.
+void InputCollect(InputSystem *input, uint64_t nowNs);
+
+// Start a tick covering input from tickEndNs - tickNs up to tickEndNs: the
+// tick view's edges start over, the held events up to the end are applied in
+// order and the axis averages are taken over the tick.
+void InputBeginTick(InputSystem *input, uint64_t tickEndNs, uint64_t tickNs);
+
+// Apply every held event to the tick view now; their edges are dropped at the
+// next tick. For frames in which no tick runs (menus, pause), so the held
+// events don't pile up and a key released meanwhile doesn't stay down.
+void InputFlushTicks(InputSystem *input);
+
+// Forget all state and anything queued
+void InputReset(InputSystem *input);
+
+bool InputKeyDown(const InputState *state, int key);
+bool InputKeyPressed(const InputState *state, int key);
+// Down now or pressed since the edge reset, so a tap inside one tick counts
+bool InputKeyActive(const InputState *state, int key);
+bool InputMouseButtonDown(const InputState *state, int button);
+bool InputMouseButtonPressed(const InputState *state, int button);
+bool InputGamepadButtonDown(const InputState *state, int gamepad, int button);
+bool InputGamepadButtonPressed(const InputState *state, int gamepad, int button);
+float InputGamepadAxis(const InputState *state, int gamepad, int axis);
+float InputGamepadAxisMean(const InputState *state, int gamepad, int axis);
+
+float InputCurveApply(const InputCurve *curve, float value);
+
+// Parse "deadzone,exponent[,saturation]"
+bool InputCurveParse(const char *text, InputCurve *curve);
+
+#endif // PONG_INPUT_H
@@ -0,0 +1,162 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2025, BISMAYA JYOTI DALEI
+
+See the LICENSE file in the project root for the full license text.
+*/
+
+#include "inputcapture.h"
+#include "timer.h"
+#include "../include/raylib.h"
+#include <stddef.h>
+
+// From glfw3.h, which isn't in include/; the functions are linked in with
+// raylib's desktop build in lib/.
+typedef struct GLFWwindow GLFWwindow;
+typedef void (*GLFWkeyfun)(GLFWwindow *window, int key, int scancode, int action, int mods);
+typedef void (*GLFWmousebuttonfun)(GLFWwindow *window, int button, int action, int mods);
+typedef struct {
+    unsigned char buttons[15];
+    float axes[6];
+} GLFWgamepadstate;
+
+GLFWwindow *glfwGetCurrentContext(void);
+GLFWkeyfun glfwSetKeyCallback(GLFWwindow *window, GLFWkeyfun callback);
+GLFWmousebuttonfun glfwSetMouseButtonCallback(GLFWwindow *window, GLFWmousebuttonfun callback);
+int glfwGetGamepadState(int jid, GLFWgamepadstate *state);
+
+#define GLFW_RELEASE 0
+#define GLFW_PRESS 1
+#define GLFW_REPEAT 2          // Key held long enough to auto-repeat; not a new press
+
+// raylib's code for each GLFW gamepad button, the same mapping raylib uses
+static const int gamepadButtonCodes[15] = {
+    GAMEPAD_BUTTON_RIGHT_FACE_DOWN,  // A
+    GAMEPAD_BUTTON_RIGHT_FACE_RIGHT, // B
+    GAMEPAD_BUTTON_RIGHT_FACE_LEFT,  // X
+    GAMEPAD_BUTTON_RIGHT_FACE_UP,    // Y
+    GAMEPAD_BUTTON_LEFT_TRIGGER_1,   // Left bumper
+    GAMEPAD_BUTTON_RIGHT_TRIGGER_1,  // Right bumper
+    GAMEPAD_BUTTON_MIDDLE_LEFT,      // Back
+    GAMEPAD_BUTTON_MIDDLE_RIGHT,     // Start
+    GAMEPAD_BUTTON_MIDDLE,           // Guide
+    GAMEPAD_BUTTON_LEFT_THUMB,
+    GAMEPAD_BUTTON_RIGHT_THUMB,
+    GAMEPAD_BUTTON_LEFT_FACE_UP,     // D-pad
+    GAMEPAD_BUTTON_LEFT_FACE_RIGHT,
+    GAMEPAD_BUTTON_LEFT_FACE_DOWN,
+    GAMEPAD_BUTTON_LEFT_FACE_LEFT
+};
+
+static struct {
+    InputQueue *queue;
+    GLFWwindow *window;
+    GLFWkeyfun raylibKey;      // raylib's callbacks, still called for every event
+    GLFWmousebuttonfun raylibMouseButton;
+    // What was last queued for the polled devices
+    Vector2 mouse;
+    bool gamepadButtons[INPUT_MAX_GAMEPADS][INPUT_GAMEPAD_BUTTONS];
+    float gamepadAxes[INPUT_MAX_GAMEPADS][INPUT_GAMEPAD_AXES];
+} capture;
+
+static void Queue(InputEventType type, int device, int code, float value, float y) {
+    InputEvent event = {
+        .timeNs = TimerNowNs(),
+        .type = (uint8_t)type,
+        .device = (uint8_t)device,
+        .code = (uint16_t)code,
+        .value = value,
+        .y = y
+    };
+    InputQueuePush(capture.queue, &event);
+}
+
+static void KeyCallback(GLFWwindow *window, int key, int scancode, int action, int mods) {
+    if (key >= 0 && key < INPUT_KEY_COUNT && action != GLFW_REPEAT) {
+        Queue(INPUT_EVENT_KEY, 0, key, (action == GLFW_PRESS) ? 1.0f : 0.0f, 0.0f);
+    }
+    if (capture.raylibKey != NULL) capture.raylibKey(window, key, scancode, action, mods);
+}
+
+static void MouseButtonCallback(GLFWwindow *window, int button, int action, int mods) {
+    if (button >= 0 && button < INPUT_MOUSE_BUTTONS) {
+        Queue(INPUT_EVENT_MOUSE_BUTTON, 0, button, (action == GLFW_PRESS) ? 1.0f : 0.0f, 0.0f);
+    }
+    if (capture.raylibMouseButton != NULL) capture.raylibMouseButton(window, button, action, mods);
+}
+
+bool InputCaptureInit(InputQueue *queue) {
+    if (capture.window != NULL) return true;
+
+    GLFWwindow *window = glfwGetCurrentContext();
+    if (window == NULL) return false;
+
+    capture.queue = queue;
+    capture.window = window;
+    capture.mouse = GetMousePosition();
+    capture.raylibKey = glfwSetKeyCallback(window, KeyCallback);
+    capture.raylibMouseButton = glfwSetMouseButtonCallback(window, MouseButtonCallback);
+    // Start from where the cursor already is
+    Queue(INPUT_EVENT_MOUSE_MOVE, 0, 0, capture.mouse.x, capture.mouse.y);
+    return true;
+}
+
+void InputCapturePoll(void) {
+    if (capture.window == NULL) return;
+
+    Vector2 mouse = GetMousePosition();
+    if (mouse.x != capture.mouse.x || mouse.y != capture.mouse.y) {
+        Queue(INPUT_EVENT_MOUSE_MOVE, 0, 0, mouse.x, mouse.y);
+        capture.mouse = mouse;
+    }
+    InputCapturePollGamepads();
+}
+
+bool InputCapturePollGamepads(void) {
+    if (capture.window == NULL) return false;
+
+    // A gamepad that goes away reads as released buttons and centered sticks
+    bool queued = false;
+    for (int pad = 0; pad < INPUT_MAX_GAMEPADS; pad++) {
+        GLFWgamepadstate state = { 0 };
+        bool available = glfwGetGamepadState(pad, &state) != 0;
+
+        float axes[INPUT_GAMEPAD_AXES] = { 0 };
+        bool buttons[INPUT_GAMEPAD_BUTTONS] = { false };
+        if (available) {
+            for (int axis = 0; axis < 6; axis++) axes[axis] = state.axes[axis];
+            axes[GAMEPAD_AXIS_LEFT_TRIGGER] = (axes[GAMEPAD_AXIS_LEFT_TRIGGER] + 1.0f) * 0.5f;
+            axes[GAMEPAD_AXIS_RIGHT_TRIGGER] = (axes[GAMEPAD_AXIS_RIGHT_TRIGGER] + 1.0f) * 0.5f;
+            for (int b = 0; b < 15; b++) buttons[gamepadButtonCodes[b]] = state.buttons[b] == GLFW_PRESS;
+            // raylib also reports the triggers as buttons once they move
+            buttons[GAMEPAD_BUTTON_LEFT_TRIGGER_2] = axes[GAMEPAD_AXIS_LEFT_TRIGGER] > 0.55f;
+            buttons[GAMEPAD_BUTTON_RIGHT_TRIGGER_2] = axes[GAMEPAD_AXIS_RIGHT_TRIGGER] > 0.55f;
+        }
+
+        for (int button = 0; button < INPUT_GAMEPAD_BUTTONS; button++) {
+            if (buttons[button] != capture.gamepadButtons[pad][button]) {
+                Queue(INPUT_EVENT_GAMEPAD_BUTTON, pad, button, buttons[button] ? 1.0f : 0.0f, 0.0f);
+                capture.gamepadButtons[pad][button] = buttons[button];
+                queued = true;
+            }
+        }
+        for (int axis = 0; axis < INPUT_GAMEPAD_AXES; axis++) {
+            if (axes[axis] != capture.gamepadAxes[pad][axis]) {
+                Queue(INPUT_EVENT_GAMEPAD_AXIS, pad, axis, axes[axis], 0.0f);
+                capture.gamepadAxes[pad][axis] = axes[axis];
+                queued = true;
+            }
+        }
+    }
+    return queued;
+}
+
+void InputCaptureShutdown(void) {
+    if (capture.window == NULL) return;
+
+    glfwSetKeyCallback(capture.window, capture.raylibKey);
+    glfwSetMouseButtonCallback(capture.window, capture.raylibMouseButton);
+    capture.window = NULL;
+    capture.queue = NULL;
+}
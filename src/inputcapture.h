@@ -0,0 +1,44 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2025, BISMAYA JYOTI DALEI
+
+See the LICENSE file in the project root for the full license text.
+*/
+
+// Feeds an InputQueue (src/input.h) from the raylib window.
+//
+// raylib only keeps the latest state of each key, sampled when it polls the
+// window once per frame, so a key pressed and released between two polls
+// never shows up. Keys and mouse buttons are therefore taken from the GLFW
+// callbacks underneath raylib: each event is queued with its own timestamp
+// and then handed on to raylib's callback, so raylib's IsKeyDown and friends
+// keep working. GLFW has no callbacks for gamepads or for the cursor in
+// raylib's (scaled) coordinates, so InputCapturePoll compares those with the
+// last poll and queues what changed. Gamepads are read from the device
+// through GLFW rather than from raylib's copy taken at the end of the last
+// frame, and again right before every sim tick, so the tick that covers the
+// present sees the stick as it is when that tick runs. Triggers are queued from 0 (released) to 1
+// rather than raylib's -1 to 1, so they share the sticks' curves.
+
+#ifndef PONG_INPUTCAPTURE_H
+#define PONG_INPUTCAPTURE_H
+
+#include "input.h"
+
+// Start queuing window events into queue. Call after InitWindow; returns
+// false if there is no window to listen to.
+bool InputCaptureInit(InputQueue *queue);
+
+// Queue mouse movement and gamepad changes since the last call. Call once a
+// frame, before draining the queue.
+void InputCapturePoll(void);
+
+// Queue gamepad changes since the last poll; true if there were any. Call
+// right before each sim tick, then InputCollect the new events.
+bool InputCapturePollGamepads(void);
+
+// Hand the callbacks back to raylib. Call before CloseWindow.
+void InputCaptureShutdown(void);
+
+#endif // PONG_INPUTCAPTURE_H
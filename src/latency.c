@@ -0,0 +1,150 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2025, BISMAYA JYOTI DALEI
+
+See the LICENSE file in the project root for the full license text.
+*/
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 199309L
+#endif
+
+#include "latency.h"
+#include "timer.h"
+#include "../include/raylib.h"
+#include <math.h>
+#include <pthread.h>
+#include <time.h>
+
+// From rlgl.h and the GL headers, which aren't in include/
+void rlDrawRenderBatchActive(void);
+
+#if defined(_WIN32)
+#define GL_APIENTRY __stdcall
+#else
+#define GL_APIENTRY
+#endif
+void GL_APIENTRY glReadPixels(int x, int y, int width, int height, unsigned int format, unsigned int type, void *pixels);
+#define GL_RGBA 0x1908
+#define GL_UNSIGNED_BYTE 0x1401
+
+#define MARKER_SIZE 4            // Pixels; read from the middle so edges don't matter
+#define MARKER_TAG 0xA5          // Blue channel of every marker
+#define INJECTOR_POLL_NS 100000L // How often the injector checks the clock
+
+void LatencyDrawMarker(float paddleY) {
+    int code = (int)lroundf(fmaxf(paddleY, 0.0f) * 4.0f);
+    Color color = { (unsigned char)((code >> 8) & 0xFF), (unsigned char)(code & 0xFF), MARKER_TAG, 255 };
+    DrawRectangle(0, 0, MARKER_SIZE, MARKER_SIZE, color);
+}
+
+int LatencyReadMarker(void) {
+    rlDrawRenderBatchActive();
+
+    // GL counts rows from the bottom
+    unsigned char pixel[4] = { 0 };
+    glReadPixels(MARKER_SIZE / 2, GetRenderHeight() - 1 - MARKER_SIZE / 2, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixel);
+    if (pixel[2] != MARKER_TAG) return -1;
+    return (pixel[0] << 8) | pixel[1];
+}
+
+typedef enum {
+    INJECTOR_IDLE,
+    INJECTOR_ARMED,          // Waiting for armedAt
+    INJECTOR_PRESSED,        // Key is down
+    INJECTOR_RELEASING       // Main thread wants it up again
+} InjectorState;
+
+// The main thread moves IDLE -> ARMED and ARMED/PRESSED -> IDLE/RELEASING,
+// the injector ARMED -> PRESSED and RELEASING -> IDLE, so the key can't be
+// left down whatever order the two threads get there in.
+static struct {
+    InputQueue *queue;
+    pthread_t thread;
+    bool running;
+    atomic_bool stop;
+    atomic_int state;
+    atomic_int key;
+    atomic_uint_fast64_t armedAt;
+    atomic_uint_fast64_t pressedAt;
+} injector;
+
+static void SleepNs(long nanoseconds) {
+    struct timespec ts = { 0, nanoseconds };
+    nanosleep(&ts, NULL);
+}
+
+static void InjectKey(int key, bool down, uint64_t timeNs) {
+    InputEvent event = {
+        .timeNs = timeNs,
+        .type = INPUT_EVENT_KEY,
+        .code = (uint16_t)key,
+        .value = down ? 1.0f : 0.0f
+    };
+    InputQueuePush(injector.queue, &event);
+}
+
+static void *InjectorMain(void *arg) {
+    (void)arg;
+
+    while (!atomic_load(&injector.stop)) {
+        int state = atomic_load(&injector.state);
+        uint64_t now = TimerNowNs();
+        if (state == INJECTOR_ARMED && now >= atomic_load(&injector.armedAt)) {
+            // Publish the stamp first; if the press was cancelled meanwhile,
+            // nothing was queued and nothing needs releasing
+            atomic_store(&injector.pressedAt, now);
+            int armed = INJECTOR_ARMED;
+            if (atomic_compare_exchange_strong(&injector.state, &armed, INJECTOR_PRESSED)) {
+                InjectKey(atomic_load(&injector.key), true, now);
+            }
+        } else if (state == INJECTOR_RELEASING) {
+            InjectKey(atomic_load(&injector.key), false, now);
+            atomic_store(&injector.state, INJECTOR_IDLE);
+        }
+        SleepNs(INJECTOR_POLL_NS);
+    }
+    return NULL;
+}
+
+bool LatencyInjectorStart(InputQueue *queue) {
+    if (injector.running) return true;
+
+    injector.queue = queue;
+    atomic_store(&injector.stop, false);
+    atomic_store(&injector.state, INJECTOR_IDLE);
+    if (pthread_create(&injector.thread, NULL, InjectorMain, NULL) != 0) return false;
+    injector.running = true;
+    return true;
+}
+
+bool LatencyInjectorArm(int key, uint64_t atNs) {
+    if (atomic_load(&injector.state) != INJECTOR_IDLE) return false;
+
+    atomic_store(&injector.key, key);
+    atomic_store(&injector.armedAt, atNs);
+    atomic_store(&injector.state, INJECTOR_ARMED);
+    return true;
+}
+
+bool LatencyInjectorPressed(uint64_t *pressedNs) {
+    if (atomic_load(&injector.state) != INJECTOR_PRESSED) return false;
+    *pressedNs = atomic_load(&injector.pressedAt);
+    return true;
+}
+
+void LatencyInjectorRelease(void) {
+    int armed = INJECTOR_ARMED;
+    if (atomic_compare_exchange_strong(&injector.state, &armed, INJECTOR_IDLE)) return;
+    int pressed = INJECTOR_PRESSED;
+    atomic_compare_exchange_strong(&injector.state, &pressed, INJECTOR_RELEASING);
+}
+
+void LatencyInjectorStop(void) {
+    if (!injector.running) return;
+
+    atomic_store(&injector.stop, true);
+    pthread_join(injector.thread, NULL);
+    injector.running = false;
+}
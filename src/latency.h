@@ -0,0 +1,51 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2025, BISMAYA JYOTI DALEI
+
+See the LICENSE file in the project root for the full license text.
+*/
+
+// Pieces of the --latency harness that talk to the window and the input
+// queue: a marker pixel that says where a frame drew the player's paddle,
+// and a thread that injects key presses at arbitrary moments.
+//
+// The marker is a small block in the top-left corner whose color encodes the
+// paddle's drawn y in quarter pixels. LatencyReadMarker reads it back from
+// the framebuffer just before the swap, so the harness sees exactly what the
+// frame about to be presented shows, at the cost of a one-pixel glReadPixels.
+//
+// The injector thread presses a key at a requested time, independent of the
+// frame loop, the way a real key press lands at any point in a frame. It
+// pushes into an InputQueue like the window callbacks do, so it must be the
+// queue's only producer (stop src/inputcapture.c first).
+
+#ifndef PONG_LATENCY_H
+#define PONG_LATENCY_H
+
+#include "input.h"
+
+// Draw the marker for a paddle drawn at paddleY. Call outside any camera
+// transform, after the rest of the frame.
+void LatencyDrawMarker(float paddleY);
+
+// Flush drawing and read the marker back: the encoded paddle y, or -1 if the
+// marker isn't there
+int LatencyReadMarker(void);
+
+// Start the injector thread on queue; false if it couldn't be created
+bool LatencyInjectorStart(InputQueue *queue);
+
+// Press key (as an INPUT_EVENT_KEY) once TimerNowNs() reaches atNs. False
+// while the previous press is still being released.
+bool LatencyInjectorArm(int key, uint64_t atNs);
+
+// True once the armed press has been queued, with the timestamp it carries
+bool LatencyInjectorPressed(uint64_t *pressedNs);
+
+// Release the armed key, or cancel the press if it hasn't happened yet
+void LatencyInjectorRelease(void);
+
+void LatencyInjectorStop(void);
+
+#endif // PONG_LATENCY_H
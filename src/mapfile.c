@@ -0,0 +1,81 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2025, BISMAYA JYOTI DALEI
+
+See the LICENSE file in the project root for the full license text.
+*/
+
+#include "mapfile.h"
+#include <string.h>
+
+#if defined(_WIN32)
+// windows.h clashes with raylib names, which is why this lives in its own file
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+
+bool MapFileOpen(MappedFile *file, const char *path) {
+    memset(file, 0, sizeof(*file));
+
+    HANDLE handle = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (handle == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(handle, &size) || size.QuadPart == 0) {
+        CloseHandle(handle);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(handle, NULL, PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(handle);   // The mapping keeps the file open
+    if (mapping == NULL) return false;
+
+    const void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (view == NULL) {
+        CloseHandle(mapping);
+        return false;
+    }
+
+    file->data = (const unsigned char *)view;
+    file->size = (size_t)size.QuadPart;
+    file->handle = mapping;
+    return true;
+}
+
+void MapFileClose(MappedFile *file) {
+    if (file->data != NULL) UnmapViewOfFile(file->data);
+    if (file->handle != NULL) CloseHandle((HANDLE)file->handle);
+    memset(file, 0, sizeof(*file));
+}
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+bool MapFileOpen(MappedFile *file, const char *path) {
+    memset(file, 0, sizeof(*file));
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0) {
+        close(fd);
+        return false;
+    }
+
+    void *view = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);   // The mapping keeps the file open
+    if (view == MAP_FAILED) return false;
+
+    file->data = (const unsigned char *)view;
+    file->size = (size_t)info.st_size;
+    return true;
+}
+
+void MapFileClose(MappedFile *file) {
+    if (file->data != NULL) munmap((void *)file->data, file->size);
+    memset(file, 0, sizeof(*file));
+}
+#endif
@@ -0,0 +1,29 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2025, BISMAYA JYOTI DALEI
+
+See the LICENSE file in the project root for the full license text.
+*/
+
+// Read-only memory-mapped files. Pages are faulted in on demand, so large
+// replay archives or asset caches cost address space, not RAM.
+
+#ifndef PONG_MAPFILE_H
+#define PONG_MAPFILE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef struct {
+    const unsigned char *data;
+    size_t size;
+    void *handle;        // Platform mapping handle (Windows only)
+} MappedFile;
+
+// Map the whole file. Returns false if it can't be opened or is empty.
+bool MapFileOpen(MappedFile *file, const char *path);
+
+void MapFileClose(MappedFile *file);
+
+#endif // PONG_MAPFILE_H
@@ -0,0 +1,396 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2025, BISMAYA JYOTI DALEI
+
+See the LICENSE file in the project root for the full license text.
+*/
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200112L   // getaddrinfo
+#endif
+
+#include "netplay.h"
+#include "timer.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+typedef SOCKET NetSocket;
+#define NET_INVALID_SOCKET ((intptr_t)INVALID_SOCKET)
+#define NetCloseSocket closesocket
+#else
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+typedef int NetSocket;
+#define NET_INVALID_SOCKET ((intptr_t)-1)
+#define NetCloseSocket close
+#endif
+
+// Packet layout: 'P' 'N' type payload (little-endian integers)
+#define NET_PACKET_HELLO 1     // version:u8                      client -> host
+#define NET_PACKET_WELCOME 2   // seed:u64 speedBits:u32 win:u8   host -> client
+#define NET_PACKET_INPUT 3     // ack:u32 start:u32 count:u8 axis:i8[count]
+#define NET_PROTOCOL_VERSION 2   // Also bumped when SimStep changes, so both peers simulate alike
+#define NET_MAX_INPUTS_PER_PACKET 64
+#define NET_HELLO_INTERVAL 0.2    // Seconds between connection attempts
+#define NET_RESEND_INTERVAL 0.05  // Keep inputs flowing while stalled or idle
+
+static void PutU32(unsigned char *p, uint32_t v) {
+    for (int i = 0; i < 4; i++) p[i] = (unsigned char)(v >> (8 * i));
+}
+
+static uint32_t GetU32(const unsigned char *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static bool NetOpenSocket(Netplay *net, int port) {
+#ifdef _WIN32
+    WSADATA wsa;
+    if (WSAStartup(MAKEWORD(2, 2), &wsa) != 0) return false;
+#endif
+    NetSocket s = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    net->socket = (intptr_t)s;
+    if (net->socket == NET_INVALID_SOCKET) return false;
+
+    struct sockaddr_in local = { 0 };
+    local.sin_family = AF_INET;
+    local.sin_addr.s_addr = htonl(INADDR_ANY);
+    local.sin_port = htons((unsigned short)port);   // 0 lets the OS pick for clients
+    if (bind(s, (struct sockaddr *)&local, sizeof(local)) != 0) return false;
+
+    // Never block the frame on the network
+#ifdef _WIN32
+    u_long nonBlocking = 1;
+    return ioctlsocket(s, FIONBIO, &nonBlocking) == 0;
+#else
+    int flags = fcntl(s, F_GETFL, 0);
+    return flags >= 0 && fcntl(s, F_SETFL, flags | O_NONBLOCK) == 0;
+#endif
+}
+
+static void NetReset(Netplay *net, const NetConditions *conditions) {
+    memset(net, 0, sizeof(*net));
+    net->socket = NET_INVALID_SOCKET;
+    net->rollbackFrom = UINT32_MAX;
+    net->ballSpeedMultiplier = 1.0f;
+    net->winScore = SIM_DEFAULT_WIN_SCORE;
+    if (conditions != NULL) net->conditions = *conditions;
+    RngSeed(&net->conditionRng, TimerNowNs(), RNG_STREAM_NETWORK);
+    net->lastReceiveTime = TimerNowSeconds();
+}
+
+static void NetSendNow(Netplay *net, const unsigned char *bytes, int size) {
+    sendto((NetSocket)net->socket, (const char *)bytes, size, 0,
+           (const struct sockaddr *)net->peerAddress, (socklen_t)net->peerAddressLength);
+}
+
+// Every outgoing packet goes through here so the condition simulator can drop
+// or hold it back
+static void NetSend(Netplay *net, const unsigned char *bytes, int size) {
+    if (!net->havePeer) return;
+    net->lastSendTime = TimerNowSeconds();
+
+    const NetConditions *c = &net->conditions;
+    if (c->lossPercent > 0 && RngRange(&net->conditionRng, 0, 99) < c->lossPercent) return;
+
+    int delayMs = c->latencyMs;
+    if (c->jitterMs > 0) delayMs += RngRange(&net->conditionRng, -c->jitterMs, c->jitterMs);
+    if (delayMs <= 0) {
+        NetSendNow(net, bytes, size);
+        return;
+    }
+
+    // A full queue behaves like a congested link
+    if (net->delayedCount == NET_MAX_DELAYED_PACKETS) return;
+    NetDelayedPacket *packet = &net->delayed[net->delayedCount++];
+    packet->deliverAt = net->lastSendTime + delayMs / 1000.0;
+    packet->size = size;
+    memcpy(packet->bytes, bytes, (size_t)size);
+}
+
+static void NetFlushDelayed(Netplay *net) {
+    double now = TimerNowSeconds();
+    int kept = 0;
+    for (int i = 0; i < net->delayedCount; i++) {
+        NetDelayedPacket *packet = &net->delayed[i];
+        if (packet->deliverAt <= now) {
+            NetSendNow(net, packet->bytes, packet->size);
+        } else {
+            net->delayed[kept++] = *packet;
+        }
+    }
+    net->delayedCount = kept;
+}
+
+static void NetSendHello(Netplay *net) {
+    unsigned char packet[4] = { 'P', 'N', NET_PACKET_HELLO, NET_PROTOCOL_VERSION };
+    NetSend(net, packet, sizeof(packet));
+}
+
+static void NetSendWelcome(Netplay *net) {
+    unsigned char packet[16] = { 'P', 'N', NET_PACKET_WELCOME };
+    PutU32(packet + 3, (uint32_t)net->seed);
+    PutU32(packet + 7, (uint32_t)(net->seed >> 32));
+    uint32_t speedBits;
+    memcpy(&speedBits, &net->ballSpeedMultiplier, sizeof(speedBits));
+    PutU32(packet + 11, speedBits);
+    packet[15] = (unsigned char)net->winScore;
+    NetSend(net, packet, sizeof(packet));
+}
+
+// Send every local input the peer hasn't acknowledged yet
+static void NetSendInputs(Netplay *net) {
+    unsigned char packet[12 + NET_MAX_INPUTS_PER_PACKET] = { 'P', 'N', NET_PACKET_INPUT };
+    uint32_t start = net->peerAck;
+    uint32_t count = net->currentFrame - start;
+    if (count > NET_MAX_INPUTS_PER_PACKET) count = NET_MAX_INPUTS_PER_PACKET;
+
+    PutU32(packet + 3, net->remoteConfirmed);
+    PutU32(packet + 7, start);
+    packet[11] = (unsigned char)count;
+    for (uint32_t i = 0; i < count; i++) {
+        packet[12 + i] = (unsigned char)net->localInputs[(start + i) % NET_INPUT_HISTORY];
+    }
+    NetSend(net, packet, 12 + (int)count);
+}
+
+static void NetReceiveInputs(Netplay *net, const unsigned char *payload, int size) {
+    if (size < 9) return;
+    uint32_t ack = GetU32(payload);
+    uint32_t start = GetU32(payload + 4);
+    int count = payload[8];
+    if (size < 9 + count) return;
+
+    if (ack > net->peerAck && ack <= net->currentFrame) net->peerAck = ack;
+
+    for (int i = 0; i < count; i++) {
+        uint32_t frame = start + (uint32_t)i;
+        if (frame < net->remoteConfirmed) continue;
+        // Never let a far-future frame overwrite a slot we still need
+        if (frame >= net->remoteConfirmed + NET_INPUT_HISTORY / 2) break;
+
+        int slot = frame % NET_INPUT_HISTORY;
+        if (net->remoteFrameTag[slot] == frame + 1) continue;
+
+        int8_t axis = (int8_t)payload[9 + i];
+        net->remoteInputs[slot] = axis;
+        net->remoteFrameTag[slot] = frame + 1;
+
+        // Already simulated with a guess that turned out wrong
+        if (frame < net->currentFrame && net->usedRemote[slot] != axis && frame < net->rollbackFrom) {
+            net->rollbackFrom = frame;
+        }
+    }
+
+    while (net->remoteFrameTag[net->remoteConfirmed % NET_INPUT_HISTORY] == net->remoteConfirmed + 1) {
+        net->remoteConfirmed++;
+    }
+}
+
+static bool SameAddress(const Netplay *net, const void *address, int length) {
+    return net->peerAddressLength == length && memcmp(net->peerAddress, address, (size_t)length) == 0;
+}
+
+static void NetHandlePacket(Netplay *net, const unsigned char *bytes, int size,
+                            const void *from, int fromLength) {
+    if (size < 3 || bytes[0] != 'P' || bytes[1] != 'N') return;
+    int type = bytes[2];
+
+    if (net->isHost && type == NET_PACKET_HELLO) {
+        if (size < 4 || bytes[3] != NET_PROTOCOL_VERSION) return;
+        if (!net->havePeer) {
+            if (fromLength > (int)sizeof(net->peerAddress)) return;
+            memcpy(net->peerAddress, from, (size_t)fromLength);
+            net->peerAddressLength = fromLength;
+            net->havePeer = true;
+            net->status = NET_STATUS_RUNNING;
+        }
+        // Repeated hellos mean our welcome was lost
+        if (SameAddress(net, from, fromLength)) NetSendWelcome(net);
+        net->lastReceiveTime = TimerNowSeconds();
+        return;
+    }
+
+    // Everything else must come from the peer we are playing
+    if (!net->havePeer || !SameAddress(net, from, fromLength)) return;
+    net->lastReceiveTime = TimerNowSeconds();
+
+    if (!net->isHost && type == NET_PACKET_WELCOME && size >= 16) {
+        if (net->status != NET_STATUS_CONNECTING) return;
+        net->seed = (uint64_t)GetU32(bytes + 3) | ((uint64_t)GetU32(bytes + 7) << 32);
+        uint32_t speedBits = GetU32(bytes + 11);
+        memcpy(&net->ballSpeedMultiplier, &speedBits, sizeof(speedBits));
+        net->winScore = bytes[15];
+        net->status = NET_STATUS_RUNNING;
+    } else if (type == NET_PACKET_INPUT && net->status == NET_STATUS_RUNNING) {
+        NetReceiveInputs(net, bytes + 3, size - 3);
+    }
+}
+
+bool NetplayHost(Netplay *net, int port, uint64_t seed, float ballSpeedMultiplier, int winScore,
+                 const NetConditions *conditions) {
+    NetReset(net, conditions);
+    net->isHost = true;
+    net->localSide = SIM_SIDE_LEFT;
+    net->seed = seed;
+    net->ballSpeedMultiplier = ballSpeedMultiplier;
+    net->winScore = winScore;
+    net->status = NET_STATUS_CONNECTING;
+
+    if (!NetOpenSocket(net, port)) {
+        NetplayClose(net);
+        net->status = NET_STATUS_FAILED;
+        return false;
+    }
+    return true;
+}
+
+bool NetplayJoin(Netplay *net, const char *address, int port, const NetConditions *conditions) {
+    NetReset(net, conditions);
+    net->isHost = false;
+    net->localSide = SIM_SIDE_RIGHT;
+    net->status = NET_STATUS_CONNECTING;
+
+    if (!NetOpenSocket(net, 0)) {
+        NetplayClose(net);
+        net->status = NET_STATUS_FAILED;
+        return false;
+    }
+
+    struct addrinfo hints = { 0 };
+    struct addrinfo *result = NULL;
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_DGRAM;
+    char service[16];
+    snprintf(service, sizeof(service), "%d", port);
+    if (getaddrinfo(address, service, &hints, &result) != 0 || result == NULL ||
+        result->ai_addrlen > sizeof(net->peerAddress)) {
+        if (result != NULL) freeaddrinfo(result);
+        NetplayClose(net);
+        net->status = NET_STATUS_FAILED;
+        return false;
+    }
+    memcpy(net->peerAddress, result->ai_addr, result->ai_addrlen);
+    net->peerAddressLength = (int)result->ai_addrlen;
+    net->havePeer = true;
+    freeaddrinfo(result);
+
+    NetSendHello(net);
+    return true;
+}
+
+void NetplayPoll(Netplay *net) {
+    if (net->socket == NET_INVALID_SOCKET) return;
+
+    unsigned char bytes[512];
+    unsigned char from[32];
+    for (;;) {
+        socklen_t fromLength = sizeof(from);
+        int size = (int)recvfrom((NetSocket)net->socket, (char *)bytes, sizeof(bytes), 0,
+                                 (struct sockaddr *)from, &fromLength);
+        if (size <= 0) break;   // Would block (or an ICMP error on Windows)
+        NetHandlePacket(net, bytes, size, from, (int)fromLength);
+    }
+
+    double now = TimerNowSeconds();
+    if (net->status == NET_STATUS_CONNECTING && !net->isHost && now - net->lastSendTime >= NET_HELLO_INTERVAL) {
+        NetSendHello(net);
+    }
+    if (net->status == NET_STATUS_RUNNING) {
+        if (now - net->lastSendTime >= NET_RESEND_INTERVAL) NetSendInputs(net);
+        if (now - net->lastReceiveTime > NET_TIMEOUT_SECONDS) net->status = NET_STATUS_DISCONNECTED;
+    }
+
+    NetFlushDelayed(net);
+}
+
+// Remote axis for a frame: the real one if we have it, otherwise a guess
+static int8_t NetRemoteInput(const Netplay *net, uint32_t frame) {
+    int slot = frame % NET_INPUT_HISTORY;
+    if (net->remoteFrameTag[slot] == frame + 1) return net->remoteInputs[slot];
+
+    // Players tend to keep holding whatever they were holding
+    if (net->remoteConfirmed == 0) return 0;
+    return net->remoteInputs[(net->remoteConfirmed - 1) % NET_INPUT_HISTORY];
+}
+
+static int NetSimulate(Netplay *net, SimState *sim, uint32_t frame, SimEvent *events) {
+    int slot = frame % NET_INPUT_HISTORY;
+    SimSide remoteSide = (net->localSide == SIM_SIDE_LEFT) ? SIM_SIDE_RIGHT : SIM_SIDE_LEFT;
+
+    SimInput input = { { 0, 0 }, { false, false } };
+    input.axis[net->localSide] = net->localInputs[slot];
+    input.axis[remoteSide] = NetRemoteInput(net, frame);
+    net->usedRemote[slot] = input.axis[remoteSide];
+    SimSaveState(sim, input.aiControlled, net->snapshots[frame % NET_SNAPSHOT_HISTORY]);
+
+    return SimStep(sim, &input, events);
+}
+
+void NetplayResolve(Netplay *net, SimState *sim) {
+    if (net->rollbackFrom >= net->currentFrame) {
+        net->rollbackFrom = UINT32_MAX;
+        return;
+    }
+
+    // Rewind to the first wrong guess and replay up to the present. Events
+    // from these ticks were already reported (or were never real), so they
+    // are dropped.
+    SimEvent discarded[SIM_MAX_EVENTS];
+    SimLoadState(sim, net->snapshots[net->rollbackFrom % NET_SNAPSHOT_HISTORY], SIM_SAVE_FIXED_BYTES);
+    for (uint32_t frame = net->rollbackFrom; frame < net->currentFrame; frame++) {
+        NetSimulate(net, sim, frame, discarded);
+        net->resimulatedFrames++;
+    }
+    net->rollbacks++;
+    net->rollbackFrom = UINT32_MAX;
+}
+
+bool NetplayAdvance(Netplay *net, SimState *sim, int8_t localAxis, SimEvent *events, int *eventCount) {
+    *eventCount = 0;
+    if (net->status != NET_STATUS_RUNNING) return false;
+
+    NetplayResolve(net, sim);
+
+    if (net->currentFrame >= net->remoteConfirmed + NET_MAX_ROLLBACK) {
+        net->stalls++;
+        return false;
+    }
+
+    net->localInputs[net->currentFrame % NET_INPUT_HISTORY] = localAxis;
+    *eventCount = NetSimulate(net, sim, net->currentFrame, events);
+    net->currentFrame++;
+
+    NetSendInputs(net);
+    return true;
+}
+
+void NetplayClose(Netplay *net) {
+    if (net->socket != NET_INVALID_SOCKET) {
+        NetCloseSocket((NetSocket)net->socket);
+        net->socket = NET_INVALID_SOCKET;
+#ifdef _WIN32
+        WSACleanup();
+#endif
+    }
+    if (net->status != NET_STATUS_FAILED) net->status = NET_STATUS_DISCONNECTED;
+}
+
+bool NetplayParseConditions(const char *text, NetConditions *conditions) {
+    NetConditions parsed = { 0, 0, 0 };
+    int fields = sscanf(text, "%d,%d,%d", &parsed.latencyMs, &parsed.jitterMs, &parsed.lossPercent);
+    if (fields < 1 || parsed.latencyMs < 0 || parsed.jitterMs < 0 ||
+        parsed.lossPercent < 0 || parsed.lossPercent > 100) {
+        return false;
+    }
+    *conditions = parsed;
+    return true;
+}
@@ -0,0 +1,123 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2025, BISMAYA JYOTI DALEI
+
+See the LICENSE file in the project root for the full license text.
+*/
+
+// Two-player online play over UDP with GGPO-style rollback.
+//
+// Both peers run the same deterministic sim from the same seed. Each tick the
+// local paddle input is applied immediately; the remote paddle uses its last
+// confirmed input as a prediction. Every tick the state is saved into a small
+// ring (SimSaveState; both paddles are human, so no AI history), and when a late remote input turns out to differ from what was
+// predicted, the sim is rewound to that tick and re-simulated with the real
+// input. A peer that gets more than NET_MAX_ROLLBACK ticks ahead of what it
+// has confirmed from the other side stalls until it catches up.
+//
+// Inputs are sent redundantly (everything the peer hasn't acknowledged yet),
+// so lost packets cost nothing but a rollback. NetConditions adds artificial
+// latency, jitter and loss to outgoing packets for testing on one machine.
+//
+// The host plays the left paddle and picks the seed and settings.
+
+#ifndef PONG_NETPLAY_H
+#define PONG_NETPLAY_H
+
+#include "rng.h"
+#include "sim.h"
+
+#define NET_INPUT_HISTORY 128        // Ring size for inputs (power of two)
+#define NET_MAX_ROLLBACK 12          // Ticks we may run ahead of confirmed remote input
+#define NET_SNAPSHOT_HISTORY 16      // Ring size for snapshots (power of two above NET_MAX_ROLLBACK)
+#define NET_MAX_DELAYED_PACKETS 256  // Packets held back by the condition simulator
+#define NET_TIMEOUT_SECONDS 5.0
+
+typedef struct {
+    int latencyMs;      // Added one-way delay
+    int jitterMs;       // +/- random extra delay
+    int lossPercent;    // Chance of dropping a packet
+} NetConditions;
+
+typedef enum {
+    NET_STATUS_CONNECTING,
+    NET_STATUS_RUNNING,
+    NET_STATUS_DISCONNECTED,
+    NET_STATUS_FAILED           // Socket could not be set up
+} NetStatus;
+
+typedef struct {
+    double deliverAt;
+    int size;
+    unsigned char bytes[96];
+} NetDelayedPacket;
+
+typedef struct {
+    NetStatus status;
+    bool isHost;
+    SimSide localSide;
+
+    // Match settings (chosen by the host, received by the client)
+    uint64_t seed;
+    float ballSpeedMultiplier;
+    int winScore;
+
+    // Socket and peer address (opaque storage so this header stays portable)
+    intptr_t socket;
+    unsigned char peerAddress[32];
+    int peerAddressLength;
+    bool havePeer;
+    double lastReceiveTime;
+    double lastSendTime;
+
+    // Rollback state, indexed by frame % NET_INPUT_HISTORY (snapshots by
+    // frame % NET_SNAPSHOT_HISTORY: a rollback never reaches further back
+    // than NET_MAX_ROLLBACK ticks, the oldest unconfirmed remote input)
+    int8_t localInputs[NET_INPUT_HISTORY];
+    int8_t remoteInputs[NET_INPUT_HISTORY];
+    uint32_t remoteFrameTag[NET_INPUT_HISTORY];   // frame + 1 when remoteInputs holds that frame
+    int8_t usedRemote[NET_INPUT_HISTORY];         // What the sim was actually given
+    unsigned char snapshots[NET_SNAPSHOT_HISTORY][SIM_SAVE_FIXED_BYTES];   // State before simulating that frame
+    uint32_t currentFrame;        // Next frame to simulate
+    uint32_t remoteConfirmed;     // Every remote input below this frame is known
+    uint32_t peerAck;             // Every local input below this frame has reached the peer
+    uint32_t rollbackFrom;        // Earliest mispredicted frame, UINT32_MAX if none
+
+    // Condition simulator for outgoing packets
+    NetConditions conditions;
+    Rng conditionRng;
+    NetDelayedPacket delayed[NET_MAX_DELAYED_PACKETS];
+    int delayedCount;
+
+    // Stats
+    uint32_t rollbacks;
+    uint32_t resimulatedFrames;
+    uint32_t stalls;
+} Netplay;
+
+// Start hosting on port. Settings are sent to whoever joins.
+bool NetplayHost(Netplay *net, int port, uint64_t seed, float ballSpeedMultiplier, int winScore,
+                 const NetConditions *conditions);
+
+// Join a host at address:port (IPv4 address or "localhost").
+bool NetplayJoin(Netplay *net, const char *address, int port, const NetConditions *conditions);
+
+// Service the socket: handshake, incoming inputs and delayed sends. Call
+// every frame, whether or not a tick is due.
+void NetplayPoll(Netplay *net);
+
+// Run one tick with this peer's paddle axis. Rolls back first if needed.
+// Returns false (and does nothing) if we are too far ahead and must wait.
+// Events are only reported for ticks simulated for the first time.
+bool NetplayAdvance(Netplay *net, SimState *sim, int8_t localAxis, SimEvent *events, int *eventCount);
+
+// Apply any pending correction without advancing (for shutdown and tests)
+void NetplayResolve(Netplay *net, SimState *sim);
+
+void NetplayClose(Netplay *net);
+
+// Parse "latency,jitter,loss" (milliseconds, milliseconds, percent)
+bool NetplayParseConditions(const char *text, NetConditions *conditions);
+
+#endif // PONG_NETPLAY_H
@@ -0,0 +1,71 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2025, BISMAYA JYOTI DALEI
+
+See the LICENSE file in the project root for the full license text.
+*/
+
+#include "particledraw.h"
+#include <math.h>
+#include <string.h>
+
+#define DOT_TEXTURE_SIZE 64
+#define DOT_EDGE 0.85f     // Fraction of the radius that is fully opaque
+
+static Texture2D dotTexture;
+
+// White disc with a smoothed rim; the tint supplies color and alpha
+static void BuildDotTexture(void) {
+    Image image = GenImageColor(DOT_TEXTURE_SIZE, DOT_TEXTURE_SIZE, BLANK);
+    Color *pixels = (Color *)image.data;
+    float half = DOT_TEXTURE_SIZE * 0.5f;
+
+    for (int y = 0; y < DOT_TEXTURE_SIZE; y++) {
+        for (int x = 0; x < DOT_TEXTURE_SIZE; x++) {
+            float dx = (x + 0.5f - half) / half;
+            float dy = (y + 0.5f - half) / half;
+            float t = (1.0f - sqrtf(dx * dx + dy * dy)) / (1.0f - DOT_EDGE);
+            if (t <= 0.0f) continue;
+            if (t > 1.0f) t = 1.0f;
+            float alpha = t * t * (3.0f - 2.0f * t);
+            pixels[y * DOT_TEXTURE_SIZE + x] = (Color){ 255, 255, 255, (unsigned char)(alpha * 255.0f + 0.5f) };
+        }
+    }
+
+    dotTexture = LoadTextureFromImage(image);
+    UnloadImage(image);
+
+    // Particles are a few pixels across, so minify through mipmaps
+    GenTextureMipmaps(&dotTexture);
+    SetTextureFilter(dotTexture, TEXTURE_FILTER_TRILINEAR);
+    SetTextureWrap(dotTexture, TEXTURE_WRAP_CLAMP);
+}
+
+void ParticleDrawDot(Vector2 center, float radius, Color color) {
+    if (radius <= 0.0f) return;
+    if (dotTexture.id == 0) BuildDotTexture();
+
+    DrawTexturePro(dotTexture,
+                   (Rectangle){ 0, 0, DOT_TEXTURE_SIZE, DOT_TEXTURE_SIZE },
+                   (Rectangle){ center.x - radius, center.y - radius, radius * 2.0f, radius * 2.0f },
+                   (Vector2){ 0, 0 }, 0.0f, color);
+}
+
+void ParticleDrawSystem(const ParticleSystem *ps) {
+    for (int i = 0; i < ps->count; i++) {
+        Color color;
+        memcpy(&color, &ps->color[i], sizeof(color));
+
+        // Shrink and fade out over the lifetime
+        float alpha = ps->fade[i];
+        ParticleDrawDot((Vector2){ ps->x[i], ps->y[i] }, ps->size[i] * alpha, ColorAlpha(color, alpha));
+    }
+}
+
+void ParticleDrawUnload(void) {
+    if (dotTexture.id != 0) {
+        UnloadTexture(dotTexture);
+        dotTexture = (Texture2D){ 0 };
+    }
+}
@@ -0,0 +1,31 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2025, BISMAYA JYOTI DALEI
+
+See the LICENSE file in the project root for the full license text.
+*/
+
+// Particle and background-dot renderer.
+//
+// raylib's DrawCircle tessellates a 36-segment circle (72 vertices) on every
+// call. Here every dot is one quad (4 vertices) textured with a soft circle
+// that is rendered once. All dots share that texture, so raylib's render batch
+// keeps a run of them in a single draw call until its buffer fills.
+
+#ifndef PONG_PARTICLEDRAW_H
+#define PONG_PARTICLEDRAW_H
+
+#include "../include/raylib.h"
+#include "particles.h"
+
+// One soft dot of the given radius, tinted by color (alpha included)
+void ParticleDrawDot(Vector2 center, float radius, Color color);
+
+// Every live particle in ps, shrunk and faded by its age
+void ParticleDrawSystem(const ParticleSystem *ps);
+
+// Free the dot texture (call before CloseWindow)
+void ParticleDrawUnload(void);
+
+#endif // PONG_PARTICLEDRAW_H
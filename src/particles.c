@@ -0,0 +1,177 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2025, BISMAYA JYOTI DALEI
+
+See the LICENSE file in the project root for the full license text.
+*/
+
+#include "particles.h"
+#include <stdlib.h>
+#include <string.h>
+
+#if PARTICLE_LANES > 1
+#include <immintrin.h>
+#endif
+
+#define PARTICLE_ALIGNMENT 64
+#define PARTICLE_FIELD_COUNT 9
+
+bool ParticleSystemInit(ParticleSystem *ps, int capacity) {
+    memset(ps, 0, sizeof(*ps));
+    if (capacity <= 0) return false;
+
+    // Whole vectors only, so the SIMD sweep never needs a scalar tail
+    capacity = (capacity + PARTICLE_LANES - 1) / PARTICLE_LANES * PARTICLE_LANES;
+    size_t fieldBytes = ((size_t)capacity * 4 + PARTICLE_ALIGNMENT - 1) / PARTICLE_ALIGNMENT * PARTICLE_ALIGNMENT;
+
+    ps->memory = malloc(fieldBytes * PARTICLE_FIELD_COUNT + PARTICLE_ALIGNMENT);
+    if (ps->memory == NULL) return false;
+
+    unsigned char *base = (unsigned char *)(((uintptr_t)ps->memory + PARTICLE_ALIGNMENT - 1) &
+                                            ~(uintptr_t)(PARTICLE_ALIGNMENT - 1));
+    memset(base, 0, fieldBytes * PARTICLE_FIELD_COUNT);
+
+    void **fields[PARTICLE_FIELD_COUNT] = {
+        (void **)&ps->x, (void **)&ps->y, (void **)&ps->vx, (void **)&ps->vy,
+        (void **)&ps->age, (void **)&ps->invLifetime, (void **)&ps->size,
+        (void **)&ps->fade, (void **)&ps->color
+    };
+    for (int f = 0; f < PARTICLE_FIELD_COUNT; f++) {
+        *fields[f] = base + fieldBytes * (size_t)f;
+    }
+
+    ps->capacity = capacity;
+    return true;
+}
+
+void ParticleSystemFree(ParticleSystem *ps) {
+    free(ps->memory);
+    memset(ps, 0, sizeof(*ps));
+}
+
+void ParticleClear(ParticleSystem *ps) {
+    ps->count = 0;
+}
+
+bool ParticleSpawn(ParticleSystem *ps, float x, float y, float vx, float vy,
+                   float lifetime, float size, uint32_t color) {
+    if (ps->count >= ps->capacity || lifetime <= 0.0f) return false;
+
+    int i = ps->count++;
+    ps->x[i] = x;
+    ps->y[i] = y;
+    ps->vx[i] = vx;
+    ps->vy[i] = vy;
+    ps->age[i] = 0.0f;
+    ps->invLifetime[i] = 1.0f / lifetime;
+    ps->size[i] = size;
+    ps->fade[i] = 1.0f;
+    ps->color[i] = color;
+    return true;
+}
+
+void ParticleKill(ParticleSystem *ps, int i) {
+    int last = --ps->count;
+    if (i == last) return;
+
+    ps->x[i] = ps->x[last];
+    ps->y[i] = ps->y[last];
+    ps->vx[i] = ps->vx[last];
+    ps->vy[i] = ps->vy[last];
+    ps->age[i] = ps->age[last];
+    ps->invLifetime[i] = ps->invLifetime[last];
+    ps->size[i] = ps->size[last];
+    ps->fade[i] = ps->fade[last];
+    ps->color[i] = ps->color[last];
+}
+
+// Kill everything that faded out. Walking backwards means the particle moved
+// into a freed slot has already been checked and is alive.
+static void RemoveDead(ParticleSystem *ps) {
+    for (int i = ps->count - 1; i >= 0; i--) {
+        if (ps->fade[i] <= 0.0f) ParticleKill(ps, i);
+    }
+}
+
+void ParticleUpdateScalar(ParticleSystem *ps, float dt) {
+    for (int i = 0; i < ps->count; i++) {
+        ps->age[i] += dt;
+        ps->x[i] += ps->vx[i] * dt;
+        ps->y[i] += ps->vy[i] * dt;
+        ps->fade[i] = 1.0f - ps->age[i] * ps->invLifetime[i];
+    }
+    RemoveDead(ps);
+}
+
+#if PARTICLE_LANES == 8
+
+#define PF           __m256
+#define PF_SET1      _mm256_set1_ps
+#define PF_LOAD      _mm256_load_ps
+#define PF_STORE     _mm256_store_ps
+#define PF_ADD       _mm256_add_ps
+#define PF_SUB       _mm256_sub_ps
+#define PF_MUL       _mm256_mul_ps
+#define PF_DEAD(a)   _mm256_movemask_ps(_mm256_cmp_ps((a), _mm256_setzero_ps(), _CMP_LE_OQ))
+
+#elif PARTICLE_LANES == 4
+
+#define PF           __m128
+#define PF_SET1      _mm_set1_ps
+#define PF_LOAD      _mm_load_ps
+#define PF_STORE     _mm_store_ps
+#define PF_ADD       _mm_add_ps
+#define PF_SUB       _mm_sub_ps
+#define PF_MUL       _mm_mul_ps
+#define PF_DEAD(a)   _mm_movemask_ps(_mm_cmple_ps((a), _mm_setzero_ps()))
+
+#endif
+
+#if PARTICLE_LANES > 1
+
+void ParticleUpdate(ParticleSystem *ps, float dt) {
+    const PF vdt = PF_SET1(dt);
+    const PF one = PF_SET1(1.0f);
+
+    // Lanes past count are padding inside capacity; updating them is harmless
+    for (int i = 0; i < ps->count; i += PARTICLE_LANES) {
+        PF age = PF_ADD(PF_LOAD(&ps->age[i]), vdt);
+        PF x = PF_ADD(PF_LOAD(&ps->x[i]), PF_MUL(PF_LOAD(&ps->vx[i]), vdt));
+        PF y = PF_ADD(PF_LOAD(&ps->y[i]), PF_MUL(PF_LOAD(&ps->vy[i]), vdt));
+        PF fade = PF_SUB(one, PF_MUL(age, PF_LOAD(&ps->invLifetime[i])));
+
+        PF_STORE(&ps->age[i], age);
+        PF_STORE(&ps->x[i], x);
+        PF_STORE(&ps->y[i], y);
+        PF_STORE(&ps->fade[i], fade);
+    }
+
+    // Same backwards removal as RemoveDead, but a whole vector of survivors
+    // costs one compare
+    int vectors = (ps->count + PARTICLE_LANES - 1) / PARTICLE_LANES;
+    for (int v = vectors - 1; v >= 0; v--) {
+        int base = v * PARTICLE_LANES;
+        int dead = PF_DEAD(PF_LOAD(&ps->fade[base]));
+        for (int lane = PARTICLE_LANES - 1; dead != 0 && lane >= 0; lane--) {
+            // Padding lanes past count don't exist
+            if ((dead >> lane & 1) && base + lane < ps->count) ParticleKill(ps, base + lane);
+        }
+    }
+}
+
+const char *ParticleKernelName(void) {
+    return (PARTICLE_LANES == 8) ? "avx2" : "sse2";
+}
+
+#else
+
+void ParticleUpdate(ParticleSystem *ps, float dt) {
+    ParticleUpdateScalar(ps, dt);
+}
+
+const char *ParticleKernelName(void) {
+    return "scalar";
+}
+
+#endif
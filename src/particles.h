@@ -0,0 +1,74 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2025, BISMAYA JYOTI DALEI
+
+See the LICENSE file in the project root for the full license text.
+*/
+
+// Structure-of-arrays particle engine.
+//
+// Every attribute lives in its own lane-aligned array and live particles are
+// kept packed at the front, so the update pass is a straight SIMD sweep
+// (AVX2 8 lanes or SSE2 4 lanes, same build switch as src/sim_soa.h) with no
+// holes to skip. Spawning appends and killing moves the last particle into
+// the freed slot, so both are O(1) and nothing is ever compacted wholesale.
+// Update and draw are separate: ParticleUpdate integrates and fades, and the
+// front end reads the arrays to draw however it likes.
+//
+// No raylib in here, so the engine can be benchmarked headless.
+
+#ifndef PONG_PARTICLES_H
+#define PONG_PARTICLES_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#if defined(__AVX2__)
+#define PARTICLE_LANES 8
+#elif defined(__SSE2__) || defined(_M_X64)
+#define PARTICLE_LANES 4
+#else
+#define PARTICLE_LANES 1
+#endif
+
+typedef struct {
+    int count;           // Live particles, packed in [0, count)
+    int capacity;
+    float *x;
+    float *y;
+    float *vx;           // Pixels per second
+    float *vy;
+    float *age;          // Seconds since spawn
+    float *invLifetime;  // 1 / lifetime, so fading is a multiply
+    float *size;         // Radius at spawn
+    float *fade;         // 1 at spawn down to 0 at death, written by ParticleUpdate
+    uint32_t *color;     // RGBA bytes in memory order (same layout as raylib's Color)
+    void *memory;        // Backing allocation for all of the above
+} ParticleSystem;
+
+// Allocate room for capacity particles. Returns false on allocation failure.
+bool ParticleSystemInit(ParticleSystem *ps, int capacity);
+void ParticleSystemFree(ParticleSystem *ps);
+
+// Remove every particle
+void ParticleClear(ParticleSystem *ps);
+
+// Add a particle. Returns false (and drops it) only if the system is full.
+bool ParticleSpawn(ParticleSystem *ps, float x, float y, float vx, float vy,
+                   float lifetime, float size, uint32_t color);
+
+// Remove particle i; the last particle takes its index
+void ParticleKill(ParticleSystem *ps, int i);
+
+// Advance every particle by dt seconds and drop the ones that faded out
+void ParticleUpdate(ParticleSystem *ps, float dt);
+
+// Same update one particle at a time. Reference for the SIMD kernel and the
+// baseline it is measured against.
+void ParticleUpdateScalar(ParticleSystem *ps, float dt);
+
+// Name of the kernel compiled in ("avx2", "sse2" or "scalar")
+const char *ParticleKernelName(void);
+
+#endif // PONG_PARTICLES_H
@@ -0,0 +1,140 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2025, BISMAYA JYOTI DALEI
+
+See the LICENSE file in the project root for the full license text.
+*/
+
+#include "profiler.h"
+#include "timer.h"
+#include <stdlib.h>
+#include <string.h>
+
+static const char *stageNames[PROFILE_STAGE_COUNT + 1] = {
+    [PROFILE_MUSIC] = "music",
+    [PROFILE_UPDATE] = "update",
+    [PROFILE_COURT_BAKE] = "court bake",
+    [PROFILE_COURT] = "court",
+    [PROFILE_ENTITIES] = "paddles+ball",
+    [PROFILE_PARTICLES] = "particles",
+    [PROFILE_HUD] = "hud",
+    [PROFILE_PRESENT] = "present",
+    [PROFILE_STAGE_COUNT] = "frame"
+};
+
+void ProfilerSetEnabled(Profiler *profiler, bool enabled) {
+    memset(profiler, 0, sizeof(*profiler));
+    profiler->enabled = enabled;
+}
+
+void ProfilerBeginFrame(Profiler *profiler) {
+    if (!profiler->enabled) return;
+
+    memset(profiler->stageNs, 0, sizeof(profiler->stageNs));
+    memset(profiler->stageDrawCalls, 0, sizeof(profiler->stageDrawCalls));
+    memset(profiler->stageVertices, 0, sizeof(profiler->stageVertices));
+    profiler->frameStart = TimerNowNs();
+}
+
+void ProfilerBegin(Profiler *profiler, ProfileStage stage) {
+    if (!profiler->enabled) return;
+    profiler->stageStart[stage] = TimerNowNs();
+}
+
+void ProfilerEnd(Profiler *profiler, ProfileStage stage) {
+    if (!profiler->enabled) return;
+    profiler->stageNs[stage] += TimerNowNs() - profiler->stageStart[stage];
+}
+
+void ProfilerAddDraws(Profiler *profiler, ProfileStage stage, int drawCalls, int vertices) {
+    if (!profiler->enabled) return;
+    profiler->stageDrawCalls[stage] += drawCalls;
+    profiler->stageVertices[stage] += vertices;
+}
+
+void ProfilerEndFrame(Profiler *profiler) {
+    if (!profiler->enabled || profiler->frameStart == 0) return;
+
+    int slot = profiler->next;
+    ProfileSample total = { 0 };
+    for (int stage = 0; stage < PROFILE_STAGE_COUNT; stage++) {
+        ProfileSample *sample = &profiler->window[stage][slot];
+        sample->ms = (float)(profiler->stageNs[stage] / 1e6);
+        sample->drawCalls = profiler->stageDrawCalls[stage];
+        sample->vertices = profiler->stageVertices[stage];
+        total.drawCalls += sample->drawCalls;
+        total.vertices += sample->vertices;
+    }
+    total.ms = (float)((TimerNowNs() - profiler->frameStart) / 1e6);
+    profiler->window[PROFILE_STAGE_COUNT][slot] = total;
+
+    profiler->next = (slot + 1) % PROFILE_WINDOW;
+    if (profiler->frames < PROFILE_WINDOW) profiler->frames++;
+    profiler->frameStart = 0;
+}
+
+ProfileSample ProfilerLastFrame(const Profiler *profiler, int stage) {
+    ProfileSample none = { 0 };
+    if (profiler->frames == 0 || stage < 0 || stage > PROFILE_STAGE_COUNT) return none;
+    return profiler->window[stage][(profiler->next + PROFILE_WINDOW - 1) % PROFILE_WINDOW];
+}
+
+static int CompareMs(const void *a, const void *b) {
+    float x = ((const ProfileSample *)a)->ms;
+    float y = ((const ProfileSample *)b)->ms;
+    return (x > y) - (x < y);
+}
+
+static int CompareDrawCalls(const void *a, const void *b) {
+    int x = ((const ProfileSample *)a)->drawCalls;
+    int y = ((const ProfileSample *)b)->drawCalls;
+    return (x > y) - (x < y);
+}
+
+static int CompareVertices(const void *a, const void *b) {
+    int x = ((const ProfileSample *)a)->vertices;
+    int y = ((const ProfileSample *)b)->vertices;
+    return (x > y) - (x < y);
+}
+
+// Nearest-rank percentile of a sorted array
+static int Rank(int count, int percent) {
+    int rank = (count * percent + 99) / 100;
+    return (rank > 0) ? rank - 1 : 0;
+}
+
+ProfileSummary ProfileSummarizeSamples(ProfileSample *samples, int count) {
+    ProfileSummary summary = { 0 };
+    if (count <= 0) return summary;
+
+    double sum = 0.0;
+    for (int i = 0; i < count; i++) sum += samples[i].ms;
+    summary.mean = (float)(sum / count);
+
+    qsort(samples, (size_t)count, sizeof(ProfileSample), CompareMs);
+    summary.p50 = samples[Rank(count, 50)].ms;
+    summary.p95 = samples[Rank(count, 95)].ms;
+    summary.p99 = samples[Rank(count, 99)].ms;
+    summary.max = samples[count - 1].ms;
+
+    qsort(samples, (size_t)count, sizeof(ProfileSample), CompareDrawCalls);
+    summary.drawCalls = samples[Rank(count, 50)].drawCalls;
+    qsort(samples, (size_t)count, sizeof(ProfileSample), CompareVertices);
+    summary.vertices = samples[Rank(count, 50)].vertices;
+    return summary;
+}
+
+void ProfilerSummarize(Profiler *profiler) {
+    if (profiler->frames == 0) return;
+
+    ProfileSample samples[PROFILE_WINDOW];
+    for (int stage = 0; stage <= PROFILE_STAGE_COUNT; stage++) {
+        memcpy(samples, profiler->window[stage], sizeof(ProfileSample) * (size_t)profiler->frames);
+        profiler->summary[stage] = ProfileSummarizeSamples(samples, profiler->frames);
+    }
+}
+
+const char *ProfilerStageName(int stage) {
+    return (stage >= 0 && stage <= PROFILE_STAGE_COUNT) ? stageNames[stage] : "?";
+}
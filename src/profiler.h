@@ -0,0 +1,98 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2025, BISMAYA JYOTI DALEI
+
+See the LICENSE file in the project root for the full license text.
+*/
+
+// Per-stage frame profiler behind the F3 overlay.
+//
+// Each frame, the main loop brackets its stages with ProfilerBegin/End (a
+// stage may be entered several times; its pieces add up) and reports the
+// draw calls each stage submitted. ProfilerEndFrame pushes the totals into a
+// rolling window of the last PROFILE_WINDOW frames, and ProfilerSummarize
+// turns that window into p50/p95/p99 per stage. While disabled every call
+// returns immediately.
+//
+// No raylib in here; timings come from src/timer.h.
+
+#ifndef PONG_PROFILER_H
+#define PONG_PROFILER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define PROFILE_WINDOW 240   // Frames of history (4 seconds at 60 FPS)
+
+typedef enum {
+    PROFILE_MUSIC,           // UpdateMusicStream
+    PROFILE_UPDATE,          // Input and sim ticks (UpdateGame)
+    PROFILE_COURT_BAKE,      // Re-rendering the gradient and court layer (only after a resize)
+    PROFILE_COURT,           // Drawing the cached court layer
+    PROFILE_ENTITIES,        // Paddles and ball
+    PROFILE_PARTICLES,       // Particle update and draw
+    PROFILE_HUD,             // Scores, messages and hints
+    PROFILE_PRESENT,         // EndDrawing: batch flush, swap and frame cap wait
+    PROFILE_STAGE_COUNT
+} ProfileStage;
+
+// One stage of one frame
+typedef struct {
+    float ms;
+    int drawCalls;
+    int vertices;
+} ProfileSample;
+
+typedef struct {
+    float p50;               // Milliseconds
+    float p95;
+    float p99;
+    float mean;
+    float max;
+    int drawCalls;           // Median per frame
+    int vertices;
+} ProfileSummary;
+
+typedef struct {
+    bool enabled;
+    // Frame in progress
+    uint64_t frameStart;
+    uint64_t stageStart[PROFILE_STAGE_COUNT];
+    uint64_t stageNs[PROFILE_STAGE_COUNT];
+    int stageDrawCalls[PROFILE_STAGE_COUNT];
+    int stageVertices[PROFILE_STAGE_COUNT];
+    // Rolling window; index PROFILE_STAGE_COUNT holds the whole frame
+    ProfileSample window[PROFILE_STAGE_COUNT + 1][PROFILE_WINDOW];
+    int next;                // Window slot the next frame goes into
+    int frames;              // Frames in the window, up to PROFILE_WINDOW
+    // Output of the last ProfilerSummarize, same indexing as the window
+    ProfileSummary summary[PROFILE_STAGE_COUNT + 1];
+} Profiler;
+
+// Start or stop collecting. Enabling clears the window.
+void ProfilerSetEnabled(Profiler *profiler, bool enabled);
+
+void ProfilerBeginFrame(Profiler *profiler);
+void ProfilerBegin(Profiler *profiler, ProfileStage stage);
+void ProfilerEnd(Profiler *profiler, ProfileStage stage);
+
+// Charge draw calls and vertices submitted during a stage
+void ProfilerAddDraws(Profiler *profiler, ProfileStage stage, int drawCalls, int vertices);
+
+// Commit the frame to the window. Frames without a ProfilerBeginFrame are ignored.
+void ProfilerEndFrame(Profiler *profiler);
+
+// Recompute summary[] from the window
+void ProfilerSummarize(Profiler *profiler);
+
+// The last committed frame's sample for a stage (PROFILE_STAGE_COUNT for the whole frame)
+ProfileSample ProfilerLastFrame(const Profiler *profiler, int stage);
+
+// Percentiles, mean and max of any set of samples (reorders them)
+ProfileSummary ProfileSummarizeSamples(ProfileSample *samples, int count);
+
+// Short label for a stage, "frame" for PROFILE_STAGE_COUNT
+const char *ProfilerStageName(int stage);
+
+#endif // PONG_PROFILER_H
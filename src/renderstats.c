@@ -0,0 +1,77 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2025, BISMAYA JYOTI DALEI
+
+See the LICENSE file in the project root for the full license text.
+*/
+
+#include "renderstats.h"
+#include <stddef.h>
+
+// The batch types and functions below are from raylib 5.5's rlgl.h, which
+// isn't in include/. Only the fields read here are spelled out; the layout
+// must match the library in lib/.
+typedef struct {
+    int mode;
+    int vertexCount;
+    int vertexAlignment;
+    unsigned int textureId;
+} rlDrawCall;
+
+typedef struct {
+    int bufferCount;
+    int currentBuffer;
+    void *vertexBuffer;
+    rlDrawCall *draws;
+    int drawCounter;
+    float currentDepth;
+} rlRenderBatch;
+
+rlRenderBatch rlLoadRenderBatch(int numBuffers, int bufferElements);
+void rlUnloadRenderBatch(rlRenderBatch batch);
+void rlSetRenderBatchActive(rlRenderBatch *batch);
+void rlDrawRenderBatchActive(void);
+
+// raylib's defaults for desktop GL (RL_DEFAULT_BATCH_BUFFERS, RL_DEFAULT_BATCH_BUFFER_ELEMENTS)
+#define BATCH_BUFFERS 1
+#define BATCH_ELEMENTS 8192
+
+static struct {
+    rlRenderBatch batch;
+    bool active;
+} stats;
+
+bool RenderStatsInit(void) {
+    if (stats.active) return true;
+
+    stats.batch = rlLoadRenderBatch(BATCH_BUFFERS, BATCH_ELEMENTS);
+    if (stats.batch.vertexBuffer == NULL || stats.batch.draws == NULL) return false;
+
+    rlSetRenderBatchActive(&stats.batch);
+    stats.active = true;
+    return true;
+}
+
+void RenderStatsFlush(int *drawCalls, int *vertices) {
+    *drawCalls = 0;
+    *vertices = 0;
+    if (!stats.active) return;
+
+    // Empty entries (e.g. the one left open after the last flush) issue nothing
+    for (int i = 0; i < stats.batch.drawCounter; i++) {
+        if (stats.batch.draws[i].vertexCount <= 0) continue;
+        (*drawCalls)++;
+        *vertices += stats.batch.draws[i].vertexCount;
+    }
+    rlDrawRenderBatchActive();
+}
+
+void RenderStatsUnload(void) {
+    if (!stats.active) return;
+
+    // Passing NULL flushes ours and switches back to raylib's default batch
+    rlSetRenderBatchActive(NULL);
+    rlUnloadRenderBatch(stats.batch);
+    stats.active = false;
+}
@@ -0,0 +1,38 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2025, BISMAYA JYOTI DALEI
+
+See the LICENSE file in the project root for the full license text.
+*/
+
+// Draw call and vertex counts from raylib's render batch.
+//
+// raylib queues shapes, text and textures into one rlgl batch and only turns
+// it into GL draw calls when the batch is flushed (texture or mode changes,
+// BeginMode2D/EndMode2D, EndDrawing). To see what a piece of drawing cost,
+// RenderStatsInit swaps in a batch of our own with raylib's default size,
+// and RenderStatsFlush counts what is queued and flushes it, so calling it
+// at the end of each stage attributes every draw call to the stage that
+// queued it.
+//
+// Flushes raylib makes on its own (including when a stage overflows the
+// batch) are not seen, so the counts are a lower bound. Extra flushes also
+// split batches that would otherwise merge, so only flush while profiling.
+
+#ifndef PONG_RENDERSTATS_H
+#define PONG_RENDERSTATS_H
+
+#include "../include/raylib.h"
+
+// Install the counting batch. Call after InitWindow; returns false (and
+// leaves raylib's batch in place) if it couldn't be created.
+bool RenderStatsInit(void);
+
+// Count the draw calls and vertices queued since the last flush, then flush
+void RenderStatsFlush(int *drawCalls, int *vertices);
+
+// Restore raylib's own batch. Call before CloseWindow.
+void RenderStatsUnload(void);
+
+#endif // PONG_RENDERSTATS_H
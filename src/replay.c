@@ -0,0 +1,543 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2025, BISMAYA JYOTI DALEI
+
+See the LICENSE file in the project root for the full license text.
+*/
+
+#include "replay.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define REPLAY_CHUNK_SIZE 4096
+
+//----------------------------------------------------------------------------------
+// Encoding helpers
+//----------------------------------------------------------------------------------
+
+static size_t PutVarint(unsigned char *out, uint64_t value) {
+    size_t n = 0;
+    while (value >= 0x80) {
+        out[n++] = (unsigned char)(value | 0x80);
+        value >>= 7;
+    }
+    out[n++] = (unsigned char)value;
+    return n;
+}
+
+static bool GetVarint(const unsigned char *data, size_t size, size_t *cursor, uint64_t *value) {
+    uint64_t result = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (*cursor >= size) return false;
+        unsigned char byte = data[(*cursor)++];
+        result |= (uint64_t)(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            *value = result;
+            return true;
+        }
+    }
+    return false;
+}
+
+// 0 idle, 1 up, 2 down, -1 if the axis isn't a plain keyboard value
+static int DigitalCode(int8_t axis) {
+    if (axis == 0) return 0;
+    if (axis == -SIM_AXIS_MAX) return 1;
+    if (axis == SIM_AXIS_MAX) return 2;
+    return -1;
+}
+
+static int8_t AxisFromCode(int code) {
+    return (code == 1) ? -SIM_AXIS_MAX : (code == 2) ? SIM_AXIS_MAX : 0;
+}
+
+static uint32_t FloatBits(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+static float FloatFromBits(uint32_t bits) {
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+//----------------------------------------------------------------------------------
+// Writer: the game thread encodes into fixed-size chunks and hands full ones
+// to a background thread that owns the FILE. The lock only guards the chunk
+// list, never a disk write.
+//----------------------------------------------------------------------------------
+
+typedef struct ReplayChunk {
+    struct ReplayChunk *next;
+    size_t used;
+    unsigned char bytes[REPLAY_CHUNK_SIZE];
+} ReplayChunk;
+
+struct ReplayWriter {
+    FILE *file;
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    ReplayChunk *queueHead;      // Full chunks waiting for the disk
+    ReplayChunk *queueTail;
+    bool closing;
+
+    // Game-thread state
+    ReplayChunk *current;
+    bool aiControlled[2];
+    SimInput runInput;
+    uint64_t runLength;
+    uint32_t frames;
+    uint64_t bytesWritten;       // Offset of the next byte in the file
+    ReplayKeyframe *keyframes;
+    int keyframeCount;
+    int keyframeCapacity;
+};
+
+static void *ReplayWriterMain(void *arg) {
+    ReplayWriter *writer = (ReplayWriter *)arg;
+
+    pthread_mutex_lock(&writer->lock);
+    for (;;) {
+        while (writer->queueHead == NULL && !writer->closing) {
+            pthread_cond_wait(&writer->wake, &writer->lock);
+        }
+        if (writer->queueHead == NULL && writer->closing) break;
+
+        // Take the whole list and write it without holding the lock
+        ReplayChunk *chunk = writer->queueHead;
+        writer->queueHead = NULL;
+        writer->queueTail = NULL;
+        pthread_mutex_unlock(&writer->lock);
+
+        while (chunk != NULL) {
+            ReplayChunk *next = chunk->next;
+            fwrite(chunk->bytes, 1, chunk->used, writer->file);
+            free(chunk);
+            chunk = next;
+        }
+
+        pthread_mutex_lock(&writer->lock);
+    }
+    pthread_mutex_unlock(&writer->lock);
+
+    fflush(writer->file);
+    return NULL;
+}
+
+static void SubmitChunk(ReplayWriter *writer) {
+    ReplayChunk *chunk = writer->current;
+    writer->current = NULL;
+    if (chunk == NULL || chunk->used == 0) {
+        free(chunk);
+        return;
+    }
+
+    pthread_mutex_lock(&writer->lock);
+    if (writer->queueTail) writer->queueTail->next = chunk;
+    else writer->queueHead = chunk;
+    writer->queueTail = chunk;
+    pthread_cond_signal(&writer->wake);
+    pthread_mutex_unlock(&writer->lock);
+}
+
+static void WriteBytes(ReplayWriter *writer, const unsigned char *bytes, size_t count) {
+    while (count > 0) {
+        if (writer->current == NULL) {
+            writer->current = calloc(1, sizeof(ReplayChunk));
+            if (writer->current == NULL) return;   // Out of memory: the tail of the replay is lost
+        }
+
+        size_t room = REPLAY_CHUNK_SIZE - writer->current->used;
+        size_t take = (count < room) ? count : room;
+        memcpy(writer->current->bytes + writer->current->used, bytes, take);
+        writer->current->used += take;
+        writer->bytesWritten += take;
+        bytes += take;
+        count -= take;
+
+        if (writer->current->used == REPLAY_CHUNK_SIZE) SubmitChunk(writer);
+    }
+}
+
+static void FlushRun(ReplayWriter *writer) {
+    if (writer->runLength == 0) return;
+
+    unsigned char record[32];
+    size_t n = 0;
+    int left = DigitalCode(writer->runInput.axis[SIM_SIDE_LEFT]);
+    int right = DigitalCode(writer->runInput.axis[SIM_SIDE_RIGHT]);
+
+    if (left >= 0 && right >= 0) {
+        record[n++] = (unsigned char)(REPLAY_TAG_DIGITAL | (left << 2) | (right << 4));
+        n += PutVarint(record + n, writer->runLength);
+    } else {
+        record[n++] = REPLAY_TAG_ANALOG;
+        n += PutVarint(record + n, writer->runLength);
+        record[n++] = (unsigned char)writer->runInput.axis[SIM_SIDE_LEFT];
+        record[n++] = (unsigned char)writer->runInput.axis[SIM_SIDE_RIGHT];
+    }
+
+    WriteBytes(writer, record, n);
+    writer->runLength = 0;
+}
+
+static void WriteKeyframe(ReplayWriter *writer, const SimState *sim) {
+    if (writer->keyframeCount == writer->keyframeCapacity) {
+        int capacity = writer->keyframeCapacity ? writer->keyframeCapacity * 2 : 64;
+        ReplayKeyframe *grown = realloc(writer->keyframes, (size_t)capacity * sizeof(ReplayKeyframe));
+        if (grown == NULL) return;   // Seeking just gets coarser
+        writer->keyframes = grown;
+        writer->keyframeCapacity = capacity;
+    }
+
+    writer->keyframes[writer->keyframeCount++] = (ReplayKeyframe){ writer->frames, (size_t)writer->bytesWritten };
+
+    unsigned char state[SIM_SAVE_MAX_BYTES];
+    size_t stateSize = SimSaveState(sim, writer->aiControlled, state);
+
+    unsigned char record[32];
+    size_t n = 0;
+    record[n++] = REPLAY_TAG_KEYFRAME;
+    n += PutVarint(record + n, writer->frames);
+    n += PutVarint(record + n, stateSize);
+    WriteBytes(writer, record, n);
+    WriteBytes(writer, state, stateSize);
+}
+
+static void WriteIndex(ReplayWriter *writer) {
+    uint64_t indexOffset = writer->bytesWritten;
+    unsigned char entry[32];
+    size_t n = PutVarint(entry, (uint64_t)writer->keyframeCount);
+    WriteBytes(writer, entry, n);
+
+    uint32_t lastFrame = 0;
+    size_t lastOffset = 0;
+    for (int i = 0; i < writer->keyframeCount; i++) {
+        n = PutVarint(entry, writer->keyframes[i].frame - lastFrame);
+        n += PutVarint(entry + n, writer->keyframes[i].offset - lastOffset);
+        WriteBytes(writer, entry, n);
+        lastFrame = writer->keyframes[i].frame;
+        lastOffset = writer->keyframes[i].offset;
+    }
+
+    unsigned char footer[16];
+    for (int i = 0; i < 4; i++) footer[i] = (unsigned char)(writer->frames >> (8 * i));
+    for (int i = 0; i < 8; i++) footer[4 + i] = (unsigned char)(indexOffset >> (8 * i));
+    memcpy(footer + 12, REPLAY_INDEX_MAGIC, 4);
+    WriteBytes(writer, footer, sizeof(footer));
+}
+
+ReplayWriter *ReplayWriterOpen(const char *path, const ReplayHeader *header) {
+    FILE *file = fopen(path, "wb");
+    if (file == NULL) return NULL;
+
+    ReplayWriter *writer = calloc(1, sizeof(ReplayWriter));
+    if (writer == NULL) {
+        fclose(file);
+        return NULL;
+    }
+
+    writer->file = file;
+    writer->aiControlled[SIM_SIDE_LEFT] = header->aiControlled[SIM_SIDE_LEFT];
+    writer->aiControlled[SIM_SIDE_RIGHT] = header->aiControlled[SIM_SIDE_RIGHT];
+    pthread_mutex_init(&writer->lock, NULL);
+    pthread_cond_init(&writer->wake, NULL);
+
+    if (pthread_create(&writer->thread, NULL, ReplayWriterMain, writer) != 0) {
+        pthread_cond_destroy(&writer->wake);
+        pthread_mutex_destroy(&writer->lock);
+        fclose(file);
+        free(writer);
+        return NULL;
+    }
+
+    unsigned char bytes[96];
+    size_t n = 0;
+    memcpy(bytes, REPLAY_MAGIC, 4);
+    n += 4;
+    bytes[n++] = REPLAY_VERSION;
+    n += PutVarint(bytes + n, header->seed);
+    n += PutVarint(bytes + n, (uint64_t)header->winScore);
+    uint32_t speedBits = FloatBits(header->ballSpeedMultiplier);
+    for (int i = 0; i < 4; i++) bytes[n++] = (unsigned char)(speedBits >> (8 * i));
+    bytes[n++] = (unsigned char)((header->aiControlled[SIM_SIDE_LEFT] ? 1 : 0) |
+                                 (header->aiControlled[SIM_SIDE_RIGHT] ? 2 : 0));
+    for (int side = SIM_SIDE_LEFT; side <= SIM_SIDE_RIGHT; side++) {
+        if (!header->aiControlled[side]) continue;
+        const SimAiProfile *profile = &header->aiProfile[side];
+        bytes[n++] = (unsigned char)profile->reactionTicks;
+        uint32_t fields[3] = { FloatBits(profile->aimError), FloatBits(profile->maxSpeed), FloatBits(profile->maxAccel) };
+        for (int f = 0; f < 3; f++) {
+            for (int i = 0; i < 4; i++) bytes[n++] = (unsigned char)(fields[f] >> (8 * i));
+        }
+    }
+    WriteBytes(writer, bytes, n);
+
+    return writer;
+}
+
+void ReplayWriterRecord(ReplayWriter *writer, const SimState *sim, const SimInput *input) {
+    if (writer->frames % REPLAY_KEYFRAME_INTERVAL == 0) {
+        // Keyframes sit between runs so a seek can start decoding right after one
+        FlushRun(writer);
+        WriteKeyframe(writer, sim);
+    }
+
+    // Axes of AI-driven sides are ignored by the sim, so don't let them break runs
+    SimInput normalized = *input;
+    for (int side = SIM_SIDE_LEFT; side <= SIM_SIDE_RIGHT; side++) {
+        if (writer->aiControlled[side]) normalized.axis[side] = 0;
+    }
+
+    bool sameAsRun = writer->runLength > 0 &&
+                     normalized.axis[SIM_SIDE_LEFT] == writer->runInput.axis[SIM_SIDE_LEFT] &&
+                     normalized.axis[SIM_SIDE_RIGHT] == writer->runInput.axis[SIM_SIDE_RIGHT];
+
+    if (!sameAsRun) {
+        FlushRun(writer);
+        writer->runInput = normalized;
+    }
+
+    writer->runLength++;
+    writer->frames++;
+}
+
+void ReplayWriterClose(ReplayWriter *writer) {
+    if (writer == NULL) return;
+
+    FlushRun(writer);
+    unsigned char end[16];
+    size_t n = 0;
+    end[n++] = REPLAY_TAG_END;
+    n += PutVarint(end + n, writer->frames);
+    WriteBytes(writer, end, n);
+    WriteIndex(writer);
+    SubmitChunk(writer);
+
+    pthread_mutex_lock(&writer->lock);
+    writer->closing = true;
+    pthread_cond_signal(&writer->wake);
+    pthread_mutex_unlock(&writer->lock);
+    pthread_join(writer->thread, NULL);
+
+    fclose(writer->file);
+    pthread_cond_destroy(&writer->wake);
+    pthread_mutex_destroy(&writer->lock);
+    free(writer->keyframes);
+    free(writer);
+}
+
+//----------------------------------------------------------------------------------
+// Reader
+//----------------------------------------------------------------------------------
+
+static bool ReadHeader(ReplayReader *reader) {
+    const unsigned char *data = reader->data;
+    if (reader->size < 5 || memcmp(data, REPLAY_MAGIC, 4) != 0 || data[4] != REPLAY_VERSION) return false;
+
+    size_t cursor = 5;
+    uint64_t seed, winScore;
+    if (!GetVarint(data, reader->size, &cursor, &seed)) return false;
+    if (!GetVarint(data, reader->size, &cursor, &winScore)) return false;
+    if (cursor + 5 > reader->size) return false;
+
+    uint32_t speedBits = 0;
+    for (int i = 0; i < 4; i++) speedBits |= (uint32_t)data[cursor++] << (8 * i);
+    unsigned char aiMask = data[cursor++];
+    for (int side = SIM_SIDE_LEFT; side <= SIM_SIDE_RIGHT; side++) {
+        if ((aiMask & (1 << side)) == 0) continue;
+        if (cursor + 13 > reader->size) return false;
+
+        SimAiProfile *profile = &reader->header.aiProfile[side];
+        profile->reactionTicks = data[cursor++];
+        uint32_t fields[3] = { 0, 0, 0 };
+        for (int f = 0; f < 3; f++) {
+            for (int i = 0; i < 4; i++) fields[f] |= (uint32_t)data[cursor++] << (8 * i);
+        }
+        profile->aimError = FloatFromBits(fields[0]);
+        profile->maxSpeed = FloatFromBits(fields[1]);
+        profile->maxAccel = FloatFromBits(fields[2]);
+    }
+
+    reader->header.seed = seed;
+    reader->header.winScore = (int)winScore;
+    reader->header.ballSpeedMultiplier = FloatFromBits(speedBits);
+    reader->header.aiControlled[SIM_SIDE_LEFT] = (aiMask & 1) != 0;
+    reader->header.aiControlled[SIM_SIDE_RIGHT] = (aiMask & 2) != 0;
+    reader->firstRecord = cursor;
+    reader->cursor = cursor;
+    return true;
+}
+
+// The index is optional: a file cut short by a crash still plays from the start
+static void ReadIndex(ReplayReader *reader) {
+    const unsigned char *data = reader->data;
+    if (reader->size < reader->firstRecord + 16) return;
+
+    const unsigned char *footer = data + reader->size - 16;
+    if (memcmp(footer + 12, REPLAY_INDEX_MAGIC, 4) != 0) return;
+
+    uint32_t totalFrames = 0;
+    uint64_t indexOffset = 0;
+    for (int i = 0; i < 4; i++) totalFrames |= (uint32_t)footer[i] << (8 * i);
+    for (int i = 0; i < 8; i++) indexOffset |= (uint64_t)footer[4 + i] << (8 * i);
+    if (indexOffset >= reader->size - 16) return;
+
+    size_t cursor = (size_t)indexOffset;
+    size_t end = reader->size - 16;
+    uint64_t count;
+    if (!GetVarint(data, end, &cursor, &count) || count > end) return;
+
+    ReplayKeyframe *keyframes = (count > 0) ? malloc((size_t)count * sizeof(ReplayKeyframe)) : NULL;
+    if (count > 0 && keyframes == NULL) return;
+
+    uint64_t frame = 0, offset = 0;
+    for (uint64_t i = 0; i < count; i++) {
+        uint64_t frameDelta, offsetDelta;
+        if (!GetVarint(data, end, &cursor, &frameDelta) || !GetVarint(data, end, &cursor, &offsetDelta)) {
+            free(keyframes);
+            return;
+        }
+        frame += frameDelta;
+        offset += offsetDelta;
+        keyframes[i] = (ReplayKeyframe){ (uint32_t)frame, (size_t)offset };
+    }
+
+    reader->keyframes = keyframes;
+    reader->keyframeCount = (int)count;
+    reader->totalFrames = totalFrames;
+}
+
+bool ReplayReaderOpen(ReplayReader *reader, const char *path) {
+    memset(reader, 0, sizeof(*reader));
+
+    if (!MapFileOpen(&reader->file, path)) return false;
+    reader->data = reader->file.data;
+    reader->size = reader->file.size;
+
+    if (!ReadHeader(reader)) {
+        ReplayReaderClose(reader);
+        return false;
+    }
+    ReadIndex(reader);
+    return true;
+}
+
+void ReplayReaderRewind(ReplayReader *reader) {
+    reader->cursor = reader->firstRecord;
+    reader->runRemaining = 0;
+    reader->frame = 0;
+    reader->finished = false;
+}
+
+bool ReplayReaderNext(ReplayReader *reader, SimInput *input) {
+    while (reader->runRemaining == 0) {
+        if (reader->finished || reader->cursor >= reader->size) {
+            reader->finished = true;
+            return false;
+        }
+
+        unsigned char tag = reader->data[reader->cursor++];
+        uint64_t run = 0;
+
+        if ((tag & 3) == REPLAY_TAG_DIGITAL) {
+            if (!GetVarint(reader->data, reader->size, &reader->cursor, &run)) break;
+            reader->runInput.axis[SIM_SIDE_LEFT] = AxisFromCode((tag >> 2) & 3);
+            reader->runInput.axis[SIM_SIDE_RIGHT] = AxisFromCode((tag >> 4) & 3);
+        } else if (tag == REPLAY_TAG_ANALOG) {
+            if (!GetVarint(reader->data, reader->size, &reader->cursor, &run)) break;
+            if (reader->cursor + 2 > reader->size) break;
+            reader->runInput.axis[SIM_SIDE_LEFT] = (int8_t)reader->data[reader->cursor++];
+            reader->runInput.axis[SIM_SIDE_RIGHT] = (int8_t)reader->data[reader->cursor++];
+        } else if (tag == REPLAY_TAG_KEYFRAME) {
+            // Only needed when seeking; step over it
+            uint64_t frame, stateSize;
+            if (!GetVarint(reader->data, reader->size, &reader->cursor, &frame)) break;
+            if (!GetVarint(reader->data, reader->size, &reader->cursor, &stateSize)) break;
+            if (stateSize > reader->size - reader->cursor) break;   // Truncated or corrupt
+            reader->cursor += (size_t)stateSize;
+            continue;
+        } else {
+            // REPLAY_TAG_END or an unknown tag
+            reader->finished = true;
+            return false;
+        }
+
+        reader->runRemaining = run;
+    }
+
+    if (reader->runRemaining == 0) {
+        reader->finished = true;   // Truncated record
+        return false;
+    }
+
+    reader->runRemaining--;
+    reader->frame++;
+    *input = reader->runInput;
+    input->aiControlled[SIM_SIDE_LEFT] = reader->header.aiControlled[SIM_SIDE_LEFT];
+    input->aiControlled[SIM_SIDE_RIGHT] = reader->header.aiControlled[SIM_SIDE_RIGHT];
+    return true;
+}
+
+// Restore the keyframe at index i; false if its snapshot can't be used
+static bool LoadKeyframe(ReplayReader *reader, int i, SimState *sim) {
+    size_t cursor = reader->keyframes[i].offset;
+    if (cursor >= reader->size || reader->data[cursor] != REPLAY_TAG_KEYFRAME) return false;
+    cursor++;
+
+    uint64_t frame, stateSize;
+    if (!GetVarint(reader->data, reader->size, &cursor, &frame)) return false;
+    if (!GetVarint(reader->data, reader->size, &cursor, &stateSize)) return false;
+    if (stateSize > reader->size - cursor) return false;
+    if (SimLoadState(sim, reader->data + cursor, (size_t)stateSize) != stateSize) return false;
+
+    reader->cursor = cursor + (size_t)stateSize;
+    reader->runRemaining = 0;
+    reader->frame = (uint32_t)frame;
+    reader->finished = false;
+    return true;
+}
+
+uint32_t ReplayReaderSeek(ReplayReader *reader, SimState *sim, uint32_t frame) {
+    if (reader->totalFrames > 0 && frame > reader->totalFrames) frame = reader->totalFrames;
+
+    // Latest keyframe at or before the target
+    int best = -1;
+    int lo = 0, hi = reader->keyframeCount - 1;
+    while (lo <= hi) {
+        int mid = (lo + hi) / 2;
+        if (reader->keyframes[mid].frame <= frame) {
+            best = mid;
+            lo = mid + 1;
+        } else {
+            hi = mid - 1;
+        }
+    }
+
+    if (best < 0 || !LoadKeyframe(reader, best, sim)) {
+        ReplayReaderRewind(reader);
+        SimInit(sim, reader->header.ballSpeedMultiplier, reader->header.winScore, reader->header.seed);
+        for (int side = SIM_SIDE_LEFT; side <= SIM_SIDE_RIGHT; side++) {
+            if (reader->header.aiControlled[side]) SimSetAi(sim, (SimSide)side, &reader->header.aiProfile[side]);
+        }
+    }
+
+    SimInput input;
+    SimEvent events[SIM_MAX_EVENTS];
+    while (reader->frame < frame && ReplayReaderNext(reader, &input)) {
+        SimStep(sim, &input, events);
+    }
+    return reader->frame;
+}
+
+void ReplayReaderClose(ReplayReader *reader) {
+    MapFileClose(&reader->file);
+    free(reader->keyframes);
+    memset(reader, 0, sizeof(*reader));
+}
@@ -0,0 +1,116 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2025, BISMAYA JYOTI DALEI
+
+See the LICENSE file in the project root for the full license text.
+*/
+
+// Compact binary match replays.
+//
+// A match is fully determined by its seed, its settings and the SimInput fed
+// to every tick (the AI runs inside the sim from the seeded gameplay stream),
+// so a replay only stores those. Ticks with identical input are collapsed
+// into runs; a run of digital (keyboard) input costs two bytes, so a full
+// match is typically a few KB.
+//
+// Every REPLAY_KEYFRAME_INTERVAL ticks the writer also embeds a snapshot of
+// the SimState, and an index of those keyframes is appended when the file is
+// closed. Seeking restores the nearest earlier keyframe and simulates forward,
+// so any tick is reachable in at most one interval of work. Readers map the
+// file rather than loading it.
+//
+// File layout (all integers are LEB128 varints unless noted):
+//   "PPRY" version:u8 seed winScore speedBits:u32le aiMask:u8
+//   per AI side in aiMask: reactionTicks:u8 aimError maxSpeed maxAccel (f32 bits, u32le)
+//   record*  where a record is a tag byte followed by its payload:
+//     tag & 3 == REPLAY_TAG_DIGITAL  bits 2-3 / 4-5 = left / right direction
+//                                    (0 idle, 1 up, 2 down), then run length
+//     tag     == REPLAY_TAG_ANALOG   run length, left axis:i8, right axis:i8
+//     tag     == REPLAY_TAG_KEYFRAME frame, byte count, SimSaveState bytes
+//     tag     == REPLAY_TAG_END      total ticks
+//   index:   count, then (frame delta, file offset delta) per keyframe
+//   footer:  frames:u32le indexOffset:u64le "PPIX" (16 bytes; frames is the total tick count)
+//
+// Keyframes are SimSaveState output: fixed-width fields and only the ball
+// history the recorded AI sides still need, so they don't depend on how the
+// compiler laid out SimState.
+
+#ifndef PONG_REPLAY_H
+#define PONG_REPLAY_H
+
+#include "mapfile.h"
+#include "sim.h"
+#include <stddef.h>
+
+#define REPLAY_MAGIC "PPRY"
+#define REPLAY_INDEX_MAGIC "PPIX"
+#define REPLAY_VERSION 6               // Bumped whenever SimStep or the file layout changes
+#define REPLAY_KEYFRAME_INTERVAL 300   // 5 seconds at 60 ticks per second
+
+#define REPLAY_TAG_END 0x00
+#define REPLAY_TAG_DIGITAL 0x01
+#define REPLAY_TAG_ANALOG 0x02
+#define REPLAY_TAG_KEYFRAME 0x03
+
+typedef struct {
+    uint64_t seed;
+    float ballSpeedMultiplier;
+    int winScore;
+    bool aiControlled[2];
+    SimAiProfile aiProfile[2];   // How each AI side played (ignored for human sides)
+} ReplayHeader;
+
+typedef struct ReplayWriter ReplayWriter;
+
+// Start recording to path. Returns NULL if the file can't be created.
+// Encoded bytes are handed to a background thread, so recording never waits
+// on the disk.
+ReplayWriter *ReplayWriterOpen(const char *path, const ReplayHeader *header);
+
+// Append the input used for one tick. sim is the state the input is about to
+// be applied to; it is snapshotted every REPLAY_KEYFRAME_INTERVAL ticks.
+void ReplayWriterRecord(ReplayWriter *writer, const SimState *sim, const SimInput *input);
+
+// Finish the file, wait for the writer thread and free the writer
+void ReplayWriterClose(ReplayWriter *writer);
+
+typedef struct {
+    uint32_t frame;
+    size_t offset;           // File offset of the keyframe record
+} ReplayKeyframe;
+
+typedef struct {
+    ReplayHeader header;
+    MappedFile file;
+    const unsigned char *data;   // file.data
+    size_t size;
+    size_t firstRecord;      // Offset just past the header
+    size_t cursor;           // Next record
+    ReplayKeyframe *keyframes;
+    int keyframeCount;
+    uint32_t totalFrames;    // From the END record, 0 if unknown
+    SimInput runInput;       // Input for the current run
+    uint64_t runRemaining;   // Ticks left in the current run
+    uint32_t frame;          // Ticks handed out so far
+    bool finished;
+} ReplayReader;
+
+// Load a replay for playback. Returns false on a missing or malformed file.
+bool ReplayReaderOpen(ReplayReader *reader, const char *path);
+
+// Go back to the first tick
+void ReplayReaderRewind(ReplayReader *reader);
+
+// Input for the next tick; returns false once the recording is exhausted
+bool ReplayReaderNext(ReplayReader *reader, SimInput *input);
+
+// Put sim into the state it had after `frame` ticks and position the reader
+// to continue from there. Costs at most REPLAY_KEYFRAME_INTERVAL sim steps
+// when keyframes are usable. Returns the frame actually reached, which is
+// smaller than requested if the recording ends first.
+uint32_t ReplayReaderSeek(ReplayReader *reader, SimState *sim, uint32_t frame);
+
+void ReplayReaderClose(ReplayReader *reader);
+
+#endif // PONG_REPLAY_H
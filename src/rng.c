@@ -0,0 +1,76 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2025, BISMAYA JYOTI DALEI
+
+See the LICENSE file in the project root for the full license text.
+*/
+
+#include "rng.h"
+
+static uint32_t RotateLeft(uint32_t x, int k) {
+    return (x << k) | (x >> (32 - k));
+}
+
+static uint64_t SplitMix64(uint64_t *state) {
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+void RngSeed(Rng *rng, uint64_t seed, uint64_t stream) {
+    // Expand (seed, stream) through splitmix so nearby seeds give unrelated
+    // states and the all-zero state can't come out
+    uint64_t state = seed ^ (stream * 0xD1B54A32D192ED03ull);
+    uint64_t a = SplitMix64(&state);
+    uint64_t b = SplitMix64(&state);
+    rng->s[0] = (uint32_t)a;
+    rng->s[1] = (uint32_t)(a >> 32);
+    rng->s[2] = (uint32_t)b;
+    rng->s[3] = (uint32_t)(b >> 32);
+    if ((rng->s[0] | rng->s[1] | rng->s[2] | rng->s[3]) == 0) rng->s[0] = 1;
+}
+
+uint32_t RngNext(Rng *rng) {
+    uint32_t *s = rng->s;
+    uint32_t result = RotateLeft(s[1] * 5, 7) * 9;
+    uint32_t t = s[1] << 9;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = RotateLeft(s[3], 11);
+
+    return result;
+}
+
+int RngRange(Rng *rng, int min, int max) {
+    if (max < min) {
+        int tmp = max;
+        max = min;
+        min = tmp;
+    }
+
+    // Lemire's multiply-shift with rejection: unbiased, one multiply per draw
+    // Span in unsigned arithmetic, so wide ranges can't overflow int
+    uint32_t range = (uint32_t)max - (uint32_t)min + 1u;
+    if (range == 0) return (int)RngNext(rng);   // Full 32-bit span
+
+    uint64_t m = (uint64_t)RngNext(rng) * range;
+    uint32_t low = (uint32_t)m;
+    if (low < range) {
+        uint32_t threshold = (0u - range) % range;
+        while (low < threshold) {
+            m = (uint64_t)RngNext(rng) * range;
+            low = (uint32_t)m;
+        }
+    }
+    return (int)((uint32_t)min + (uint32_t)(m >> 32));
+}
+
+float RngFloat(Rng *rng) {
+    return (float)(RngNext(rng) >> 8) * (1.0f / 16777216.0f);
+}
@@ -0,0 +1,43 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2025, BISMAYA JYOTI DALEI
+
+See the LICENSE file in the project root for the full license text.
+*/
+
+// Seedable xoshiro128** generator.
+//
+// Every match owns its generators, so the same seed always reproduces the same
+// match on any thread. A (seed, stream) pair picks an independent sequence:
+// the sim draws from RNG_STREAM_GAMEPLAY and the front end uses
+// RNG_STREAM_COSMETIC for particles and shake, so visual effects can never
+// change the outcome of a match.
+
+#ifndef PONG_RNG_H
+#define PONG_RNG_H
+
+#include <stdint.h>
+
+#define RNG_STREAM_GAMEPLAY 0
+#define RNG_STREAM_COSMETIC 1
+#define RNG_STREAM_NETWORK 2     // Netplay condition simulator (loss, jitter)
+#define RNG_STREAM_LATENCY 3     // When the --latency harness presses keys
+
+typedef struct {
+    uint32_t s[4];
+} Rng;
+
+// Initialise from a 64-bit seed and stream number (any values, including zero)
+void RngSeed(Rng *rng, uint64_t seed, uint64_t stream);
+
+// Next 32 random bits
+uint32_t RngNext(Rng *rng);
+
+// Uniform integer in [min, max], same contract as raylib's GetRandomValue
+int RngRange(Rng *rng, int min, int max);
+
+// Uniform float in [0, 1)
+float RngFloat(Rng *rng);
+
+#endif // PONG_RNG_H
@@ -0,0 +1,549 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2025, BISMAYA JYOTI DALEI
+
+See the LICENSE file in the project root for the full license text.
+*/
+
+#include "sim.h"
+#include "trace.h"
+#include <ctype.h>
+#include <math.h>
+#include <string.h>
+
+static float SimClamp(float value, float min, float max) {
+    float result = (value < min) ? min : value;
+    return (result > max) ? max : result;
+}
+
+// Same test as raylib's CheckCollisionCircleRec
+static bool SimCircleRect(SimVec2 center, float radius, SimRect rec) {
+    float recCenterX = rec.x + rec.width / 2.0f;
+    float recCenterY = rec.y + rec.height / 2.0f;
+
+    float dx = fabsf(center.x - recCenterX);
+    float dy = fabsf(center.y - recCenterY);
+
+    if (dx > (rec.width / 2.0f + radius)) return false;
+    if (dy > (rec.height / 2.0f + radius)) return false;
+
+    if (dx <= (rec.width / 2.0f)) return true;
+    if (dy <= (rec.height / 2.0f)) return true;
+
+    float cornerDistanceSq = (dx - rec.width / 2.0f) * (dx - rec.width / 2.0f) +
+                             (dy - rec.height / 2.0f) * (dy - rec.height / 2.0f);
+
+    return cornerDistanceSq <= (radius * radius);
+}
+
+static void SimEmit(SimEvent *events, int *count, SimEventType type, SimSide side, SimVec2 position) {
+    if (*count < SIM_MAX_EVENTS) {
+        events[*count] = (SimEvent){ type, side, position };
+        (*count)++;
+    }
+}
+
+static void SimMovePaddle(SimPaddle *paddle, int8_t axis) {
+    paddle->rect.y += paddle->speed * (float)axis / SIM_AXIS_MAX;
+    paddle->rect.y = SimClamp(paddle->rect.y, 0, SIM_COURT_HEIGHT - paddle->rect.height);
+}
+
+void SimInit(SimState *sim, float ballSpeedMultiplier, int winScore, uint64_t seed) {
+    sim->scores[SIM_SIDE_LEFT] = 0;
+    sim->scores[SIM_SIDE_RIGHT] = 0;
+    sim->winScore = winScore;
+    sim->ballSpeedMultiplier = ballSpeedMultiplier;
+    sim->matchOver = false;
+    sim->frame = 0;
+    sim->seed = seed;
+    RngSeed(&sim->rng, seed, RNG_STREAM_GAMEPLAY);
+
+    sim->ball.radius = SIM_BALL_RADIUS;
+
+    sim->paddles[SIM_SIDE_LEFT].rect = (SimRect){
+        SIM_PADDLE_MARGIN,
+        (SIM_COURT_HEIGHT - SIM_PADDLE_HEIGHT) / 2,
+        SIM_PADDLE_WIDTH,
+        SIM_PADDLE_HEIGHT
+    };
+    sim->paddles[SIM_SIDE_LEFT].speed = SIM_PADDLE_SPEED;
+
+    sim->paddles[SIM_SIDE_RIGHT].rect = (SimRect){
+        SIM_COURT_WIDTH - SIM_PADDLE_MARGIN - SIM_PADDLE_WIDTH,
+        (SIM_COURT_HEIGHT - SIM_PADDLE_HEIGHT) / 2,
+        SIM_PADDLE_WIDTH,
+        SIM_PADDLE_HEIGHT
+    };
+    sim->paddles[SIM_SIDE_RIGHT].speed = SIM_PADDLE_SPEED;
+
+    SimResetBall(sim, SIM_SIDE_LEFT);
+
+    // Until the AIs have seen reactionTicks of play they see the serve
+    for (int i = 0; i < SIM_AI_HISTORY; i++) sim->ballHistory[i] = (SimBallSample){ sim->ball.position, sim->ball.velocity };
+    for (int side = SIM_SIDE_LEFT; side <= SIM_SIDE_RIGHT; side++) {
+        SimSetAi(sim, (SimSide)side, SimAiTierProfile(SIM_AI_NORMAL));
+    }
+}
+
+void SimSetAi(SimState *sim, SimSide side, const SimAiProfile *profile) {
+    SimAi *ai = &sim->ai[side];
+    ai->profile = *profile;
+    if (ai->profile.reactionTicks < 0) ai->profile.reactionTicks = 0;
+    if (ai->profile.reactionTicks >= SIM_AI_HISTORY) ai->profile.reactionTicks = SIM_AI_HISTORY - 1;
+    ai->intercept = (SimIntercept){ .valid = false };
+    ai->velocity = 0.0f;
+    ai->aimOffset = 0.0f;
+    ai->incoming = false;
+}
+
+// Generated by `pongbatch --calibrate --matches 2000` (Easy 30%, Normal 50%,
+// Hard 70% and Expert 85% of points against the reference model at 1x speed)
+static const SimAiProfile aiTiers[SIM_AI_TIER_COUNT] = {
+    [SIM_AI_EASY]   = { 23, 167.2f, 7.6f, 1.01f },
+    [SIM_AI_NORMAL] = { 19, 139.3f, 8.4f, 1.39f },
+    [SIM_AI_HARD]   = { 17, 126.5f, 8.8f, 1.56f },
+    [SIM_AI_EXPERT] = { 16, 119.4f, 9.0f, 1.66f },
+};
+
+static const char *aiTierNames[SIM_AI_TIER_COUNT] = {
+    [SIM_AI_EASY] = "Easy",
+    [SIM_AI_NORMAL] = "Normal",
+    [SIM_AI_HARD] = "Hard",
+    [SIM_AI_EXPERT] = "Expert",
+};
+
+// About 250 ms to react, full speed in 100 ms, and an aim that can stray past
+// the paddle's edge (half height plus ball radius is 120 px)
+static const SimAiProfile aiReference = { 15, 140.0f, SIM_PADDLE_SPEED, 2.0f };
+
+const SimAiProfile *SimAiTierProfile(SimAiTier tier) {
+    return &aiTiers[(tier >= 0 && tier < SIM_AI_TIER_COUNT) ? tier : SIM_AI_NORMAL];
+}
+
+const char *SimAiTierName(SimAiTier tier) {
+    return aiTierNames[(tier >= 0 && tier < SIM_AI_TIER_COUNT) ? tier : SIM_AI_NORMAL];
+}
+
+bool SimAiTierFromName(const char *name, SimAiTier *tier) {
+    for (int t = 0; t < SIM_AI_TIER_COUNT; t++) {
+        const char *tierName = aiTierNames[t];
+        int c = 0;
+        while (name[c] != '\0' && tierName[c] != '\0' &&
+               tolower((unsigned char)name[c]) == tolower((unsigned char)tierName[c])) c++;
+        if (name[c] == '\0' && tierName[c] == '\0') {
+            *tier = (SimAiTier)t;
+            return true;
+        }
+    }
+    return false;
+}
+
+const SimAiProfile *SimAiReferenceProfile(void) {
+    return &aiReference;
+}
+
+SimAiProfile SimAiProfileFromSkill(float skill) {
+    skill = SimClamp(skill, 0.0f, 1.0f);
+    SimAiProfile profile = {
+        .reactionTicks = (int)lroundf(30.0f - 27.0f * skill),   // 500 ms down to 50 ms
+        .aimError = 220.0f - 200.0f * skill,
+        .maxSpeed = SIM_PADDLE_SPEED * (0.5f + 0.5f * skill),
+        .maxAccel = 0.3f + 2.7f * skill
+    };
+    return profile;
+}
+
+void SimResetBall(SimState *sim, SimSide server) {
+    sim->ball.position = (SimVec2){ SIM_COURT_WIDTH / 2, SIM_COURT_HEIGHT / 2 };
+
+    // Serve towards the other side at a random angle
+    float initialSpeed = SIM_BALL_INITIAL_SPEED * sim->ballSpeedMultiplier;
+    sim->ball.velocity = (SimVec2){
+        (server == SIM_SIDE_LEFT) ? initialSpeed : -initialSpeed,
+        (float)RngRange(&sim->rng, -100, 100) / 100.0f * initialSpeed
+    };
+}
+
+float SimSweepPaddle(const SimBall *ball, SimVec2 move, const SimPaddle *paddle) {
+    SimRect rec = paddle->rect;
+    float r = ball->radius;
+    SimVec2 p = ball->position;
+
+    // Only the paddle the ball is travelling towards can be hit
+    bool leftPaddle = rec.x + rec.width / 2 < SIM_COURT_WIDTH / 2;
+    if (leftPaddle ? move.x >= 0 : move.x <= 0) return -1.0f;
+
+    // Already touching (the paddle moved into the ball): contact right away
+    if (SimCircleRect(p, r, rec)) return 0.0f;
+
+    // The ball centre hits the paddle grown by r on every side with rounded
+    // corners. Clip the move against the square-cornered box first.
+    float tEnter = 0.0f;
+    float tExit = 1.0f;
+    float lo[2] = { rec.x - r, rec.y - r };
+    float hi[2] = { rec.x + rec.width + r, rec.y + rec.height + r };
+    float from[2] = { p.x, p.y };
+    float delta[2] = { move.x, move.y };
+    for (int axis = 0; axis < 2; axis++) {
+        if (delta[axis] == 0.0f) {
+            if (from[axis] < lo[axis] || from[axis] > hi[axis]) return -1.0f;
+            continue;
+        }
+        float t1 = (lo[axis] - from[axis]) / delta[axis];
+        float t2 = (hi[axis] - from[axis]) / delta[axis];
+        if (t1 > t2) { float swap = t1; t1 = t2; t2 = swap; }
+        if (t1 > tEnter) tEnter = t1;
+        if (t2 < tExit) tExit = t2;
+        if (tEnter > tExit) return -1.0f;
+    }
+
+    // Entering through a face of the box is a hit on a flat side
+    float qx = p.x + move.x * tEnter;
+    float qy = p.y + move.y * tEnter;
+    bool besideX = qx < rec.x || qx > rec.x + rec.width;
+    bool besideY = qy < rec.y || qy > rec.y + rec.height;
+    if (!besideX || !besideY) return tEnter;
+
+    // Entering through a corner square: the only thing to hit there is the
+    // circle of radius r around that corner, and missing it misses the paddle
+    float mx = p.x - ((qx < rec.x) ? rec.x : rec.x + rec.width);
+    float my = p.y - ((qy < rec.y) ? rec.y : rec.y + rec.height);
+    float a = move.x * move.x + move.y * move.y;
+    float b = mx * move.x + my * move.y;
+    float c = mx * mx + my * my - r * r;
+    float discriminant = b * b - a * c;
+    if (b >= 0.0f || discriminant < 0.0f) return -1.0f;
+
+    float t = (-b - sqrtf(discriminant)) / a;
+    return (t <= 1.0f) ? fmaxf(t, 0.0f) : -1.0f;
+}
+
+bool SimPredictIntercept(const SimBall *ball, float contactX, float *y) {
+    float t = (contactX - ball->position.x) / ball->velocity.x;
+    if (!(t > 0.0f)) return false;
+
+    // The centre bounces between r and H - r. Unfolding those reflections
+    // turns the path into a straight line, so the answer is the straight-line
+    // height folded back into that band with period 2 * (H - 2r).
+    float span = SIM_COURT_HEIGHT - 2.0f * ball->radius;
+    float period = 2.0f * span;
+    float unfolded = ball->position.y + ball->velocity.y * t - ball->radius;
+    float m = unfolded - period * floorf(unfolded / period);
+    *y = ball->radius + ((m > span) ? period - m : m);
+    return true;
+}
+
+void SimUpdateAI(SimState *sim, SimSide side) {
+    SimPaddle *paddle = &sim->paddles[side];
+    SimAi *ai = &sim->ai[side];
+    const SimAiProfile *profile = &ai->profile;
+
+    // React to the ball as it was reactionTicks ago
+    const SimBallSample *seen = &sim->ballHistory[(sim->frame - (uint32_t)profile->reactionTicks) % SIM_AI_HISTORY];
+    const SimBall seenBall = { seen->position, seen->velocity, sim->ball.radius };
+    const SimBall *ball = &seenBall;
+
+    // Track the ball's height unless it is heading for this paddle
+    float predictedY = ball->position.y;
+
+    float direction = (side == SIM_SIDE_RIGHT) ? 1.0f : -1.0f;
+    bool incoming = ball->velocity.x * direction > 0;
+    if (incoming && !ai->incoming) {
+        // New volley: decide how far off this one will be
+        ai->aimOffset = (float)RngRange(&sim->rng, -1000, 1000) / 1000.0f * profile->aimError;
+    }
+    ai->incoming = incoming;
+
+    if (incoming) {
+        // Re-predict only when the ball's path changed since last time
+        SimIntercept *cache = &ai->intercept;
+        if (!cache->valid || cache->velocity.x != ball->velocity.x || cache->velocity.y != ball->velocity.y) {
+            // The ball centre touches the paddle one radius out from its face
+            float paddleFace = (side == SIM_SIDE_RIGHT) ? paddle->rect.x : paddle->rect.x + paddle->rect.width;
+            float contactX = paddleFace - direction * ball->radius;
+            cache->hasTarget = SimPredictIntercept(ball, contactX, &cache->y);
+            cache->velocity = ball->velocity;
+            cache->valid = true;
+        }
+        if (cache->hasTarget) predictedY = cache->y + ai->aimOffset;
+    }
+
+    // Target position (center of paddle aligned with predicted ball position)
+    float maxY = SIM_COURT_HEIGHT - paddle->rect.height;
+    float targetY = SimClamp(predictedY - paddle->rect.height / 2, 0, maxY);
+
+    // Pick the speed that still lets the paddle brake to a stop on the target,
+    // then change towards it no faster than the acceleration limit
+    float distance = targetY - paddle->rect.y;
+    float desired = 0.0f;
+    if (fabsf(distance) > 1.0f) {
+        desired = fminf(sqrtf(2.0f * profile->maxAccel * fabsf(distance)), fabsf(distance));
+        desired = fminf(desired, profile->maxSpeed);
+        if (distance < 0) desired = -desired;
+    }
+    ai->velocity += SimClamp(desired - ai->velocity, -profile->maxAccel, profile->maxAccel);
+    paddle->rect.y += ai->velocity;
+
+    // Ensure paddle stays in bounds; hitting an end stops it dead
+    if (paddle->rect.y < 0 || paddle->rect.y > maxY) {
+        paddle->rect.y = SimClamp(paddle->rect.y, 0, maxY);
+        ai->velocity = 0.0f;
+    }
+}
+
+int SimStep(SimState *sim, const SimInput *input, SimEvent *events) {
+    int eventCount = 0;
+    if (sim->matchOver) return 0;
+
+    sim->frame++;
+    sim->ballHistory[sim->frame % SIM_AI_HISTORY] = (SimBallSample){ sim->ball.position, sim->ball.velocity };
+
+    // Paddles: human axis or built-in AI
+    for (int side = SIM_SIDE_LEFT; side <= SIM_SIDE_RIGHT; side++) {
+        if (input->aiControlled[side]) {
+            uint64_t traceStart = TRACE_ZONE_BEGIN();
+            SimUpdateAI(sim, (SimSide)side);
+            TRACE_ZONE_END("SimUpdateAI", traceStart);
+        } else {
+            SimMovePaddle(&sim->paddles[side], input->axis[side]);
+        }
+    }
+
+    SimBall *ball = &sim->ball;
+
+    // Move the ball through the tick one contact at a time: find the earliest
+    // wall or paddle it touches along its path, bounce there, and carry on
+    // with the time that is left. Nothing can be skipped at any speed.
+    float remaining = 1.0f;
+    for (int contact = 0; contact < SIM_MAX_CONTACTS && remaining > 0.0f; contact++) {
+        SimVec2 move = { ball->velocity.x * remaining, ball->velocity.y * remaining };
+        float first = 1.0f;
+        int hitSide = -1;          // Paddle hit, or -1
+        bool hitWall = false;
+
+        // Top and bottom walls, where the ball's edge reaches them
+        if (move.y < 0.0f) {
+            float t = (ball->radius - ball->position.y) / move.y;
+            if (t <= first) { first = fmaxf(t, 0.0f); hitWall = true; }
+        } else if (move.y > 0.0f) {
+            float t = (SIM_COURT_HEIGHT - ball->radius - ball->position.y) / move.y;
+            if (t <= first) { first = fmaxf(t, 0.0f); hitWall = true; }
+        }
+
+        uint64_t traceStart = TRACE_ZONE_BEGIN();
+        for (int side = SIM_SIDE_LEFT; side <= SIM_SIDE_RIGHT; side++) {
+            float t = SimSweepPaddle(ball, move, &sim->paddles[side]);
+            if (t >= 0.0f && t <= first) {
+                first = t;
+                hitSide = side;
+                hitWall = false;
+            }
+        }
+        TRACE_ZONE_END("SimSweepPaddle", traceStart);
+
+        ball->position.x += move.x * first;
+        ball->position.y += move.y * first;
+        remaining *= 1.0f - first;
+
+        if (hitSide >= 0) {
+            const SimPaddle *paddle = &sim->paddles[hitSide];
+
+            // Calculate normalized hit position (-1 to 1) at the contact point
+            float hitPosition = (ball->position.y - (paddle->rect.y + paddle->rect.height / 2)) /
+                                (paddle->rect.height / 2);
+
+            // Make the ball faster with each hit, using adjusted max speed
+            float adjustedMaxSpeed = SIM_MAX_BALL_SPEED * sim->ballSpeedMultiplier;
+            float speed = fminf(fabsf(ball->velocity.x) + SIM_SPEED_INCREMENT, adjustedMaxSpeed);
+
+            // Set new velocity based on hit position (affects angle)
+            ball->velocity.x = (hitSide == SIM_SIDE_LEFT) ? speed : -speed;
+            ball->velocity.y = hitPosition * (speed * 0.75f);
+
+            SimEmit(events, &eventCount, SIM_EVENT_PADDLE_HIT, (SimSide)hitSide, ball->position);
+        } else if (hitWall) {
+            ball->velocity.y *= -1.0f;
+
+            SimSide wallSide = (ball->position.y < SIM_COURT_HEIGHT / 2) ? SIM_SIDE_LEFT : SIM_SIDE_RIGHT;
+            SimEmit(events, &eventCount, SIM_EVENT_WALL_BOUNCE, wallSide, ball->position);
+        }
+    }
+
+    // Ball out of bounds - scoring
+    if (ball->position.x < -SIM_BALL_RADIUS) {
+        sim->scores[SIM_SIDE_RIGHT]++;
+        SimEmit(events, &eventCount, SIM_EVENT_SCORE, SIM_SIDE_RIGHT, ball->position);
+        SimResetBall(sim, SIM_SIDE_RIGHT);
+    } else if (ball->position.x > SIM_COURT_WIDTH + SIM_BALL_RADIUS) {
+        sim->scores[SIM_SIDE_LEFT]++;
+        SimEmit(events, &eventCount, SIM_EVENT_SCORE, SIM_SIDE_LEFT, ball->position);
+        SimResetBall(sim, SIM_SIDE_LEFT);
+    }
+
+    // Check for game over
+    for (int side = SIM_SIDE_LEFT; side <= SIM_SIDE_RIGHT; side++) {
+        if (sim->scores[side] >= sim->winScore) {
+            sim->matchOver = true;
+            SimEmit(events, &eventCount, SIM_EVENT_MATCH_OVER, (SimSide)side, ball->position);
+            break;
+        }
+    }
+
+    return eventCount;
+}
+
+//----------------------------------------------------------------------------------
+// Compact state snapshots
+//----------------------------------------------------------------------------------
+
+static unsigned char *SimPutU32(unsigned char *out, uint32_t value) {
+    for (int i = 0; i < 4; i++) out[i] = (unsigned char)(value >> (8 * i));
+    return out + 4;
+}
+
+static unsigned char *SimPutF32(unsigned char *out, float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return SimPutU32(out, bits);
+}
+
+static uint32_t SimGetU32(const unsigned char **data) {
+    uint32_t value = 0;
+    for (int i = 0; i < 4; i++) value |= (uint32_t)(*data)[i] << (8 * i);
+    *data += 4;
+    return value;
+}
+
+static float SimGetF32(const unsigned char **data) {
+    uint32_t bits = SimGetU32(data);
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+size_t SimSaveState(const SimState *sim, const bool aiControlled[2], unsigned char *out) {
+    unsigned char *p = out;
+
+    p = SimPutF32(p, sim->ball.position.x);
+    p = SimPutF32(p, sim->ball.position.y);
+    p = SimPutF32(p, sim->ball.velocity.x);
+    p = SimPutF32(p, sim->ball.velocity.y);
+    p = SimPutF32(p, sim->ball.radius);
+    for (int side = SIM_SIDE_LEFT; side <= SIM_SIDE_RIGHT; side++) {
+        const SimPaddle *paddle = &sim->paddles[side];
+        p = SimPutF32(p, paddle->rect.x);
+        p = SimPutF32(p, paddle->rect.y);
+        p = SimPutF32(p, paddle->rect.width);
+        p = SimPutF32(p, paddle->rect.height);
+        p = SimPutF32(p, paddle->speed);
+    }
+    p = SimPutU32(p, (uint32_t)sim->scores[SIM_SIDE_LEFT]);
+    p = SimPutU32(p, (uint32_t)sim->scores[SIM_SIDE_RIGHT]);
+    p = SimPutU32(p, (uint32_t)sim->winScore);
+    p = SimPutF32(p, sim->ballSpeedMultiplier);
+    p = SimPutU32(p, sim->frame);
+    p = SimPutU32(p, (uint32_t)sim->seed);
+    p = SimPutU32(p, (uint32_t)(sim->seed >> 32));
+    for (int i = 0; i < 4; i++) p = SimPutU32(p, sim->rng.s[i]);
+
+    // matchOver, then hasTarget / valid / incoming for each side
+    unsigned char flags = sim->matchOver ? 1 : 0;
+    for (int side = SIM_SIDE_LEFT; side <= SIM_SIDE_RIGHT; side++) {
+        const SimAi *ai = &sim->ai[side];
+        flags |= (unsigned char)(((ai->intercept.hasTarget ? 1 : 0) | (ai->intercept.valid ? 2 : 0) |
+                                  (ai->incoming ? 4 : 0)) << (1 + 3 * side));
+    }
+    *p++ = flags;
+
+    int depth = 0;
+    for (int side = SIM_SIDE_LEFT; side <= SIM_SIDE_RIGHT; side++) {
+        const SimAi *ai = &sim->ai[side];
+        *p++ = (unsigned char)ai->profile.reactionTicks;
+        p = SimPutF32(p, ai->profile.aimError);
+        p = SimPutF32(p, ai->profile.maxSpeed);
+        p = SimPutF32(p, ai->profile.maxAccel);
+        p = SimPutF32(p, ai->intercept.velocity.x);
+        p = SimPutF32(p, ai->intercept.velocity.y);
+        p = SimPutF32(p, ai->intercept.y);
+        p = SimPutF32(p, ai->velocity);
+        p = SimPutF32(p, ai->aimOffset);
+        if (aiControlled[side] && ai->profile.reactionTicks > depth) depth = ai->profile.reactionTicks;
+    }
+
+    // The next tick reads frame + 1 - reactionTicks, so the AIs still need the
+    // last `depth` samples, written oldest first
+    *p++ = (unsigned char)depth;
+    for (int age = depth - 1; age >= 0; age--) {
+        const SimBallSample *sample = &sim->ballHistory[(sim->frame - (uint32_t)age) % SIM_AI_HISTORY];
+        p = SimPutF32(p, sample->position.x);
+        p = SimPutF32(p, sample->position.y);
+        p = SimPutF32(p, sample->velocity.x);
+        p = SimPutF32(p, sample->velocity.y);
+    }
+
+    return (size_t)(p - out);
+}
+
+size_t SimLoadState(SimState *sim, const unsigned char *data, size_t size) {
+    if (size < SIM_SAVE_FIXED_BYTES) return 0;
+    int depth = data[SIM_SAVE_FIXED_BYTES - 1];
+    if (depth >= SIM_AI_HISTORY || size < SIM_SAVE_FIXED_BYTES + (size_t)depth * 16) return 0;
+
+    const unsigned char *p = data;
+    sim->ball.position.x = SimGetF32(&p);
+    sim->ball.position.y = SimGetF32(&p);
+    sim->ball.velocity.x = SimGetF32(&p);
+    sim->ball.velocity.y = SimGetF32(&p);
+    sim->ball.radius = SimGetF32(&p);
+    for (int side = SIM_SIDE_LEFT; side <= SIM_SIDE_RIGHT; side++) {
+        SimPaddle *paddle = &sim->paddles[side];
+        paddle->rect.x = SimGetF32(&p);
+        paddle->rect.y = SimGetF32(&p);
+        paddle->rect.width = SimGetF32(&p);
+        paddle->rect.height = SimGetF32(&p);
+        paddle->speed = SimGetF32(&p);
+    }
+    sim->scores[SIM_SIDE_LEFT] = (int)SimGetU32(&p);
+    sim->scores[SIM_SIDE_RIGHT] = (int)SimGetU32(&p);
+    sim->winScore = (int)SimGetU32(&p);
+    sim->ballSpeedMultiplier = SimGetF32(&p);
+    sim->frame = SimGetU32(&p);
+    sim->seed = SimGetU32(&p);
+    sim->seed |= (uint64_t)SimGetU32(&p) << 32;
+    for (int i = 0; i < 4; i++) sim->rng.s[i] = SimGetU32(&p);
+
+    unsigned char flags = *p++;
+    sim->matchOver = (flags & 1) != 0;
+    for (int side = SIM_SIDE_LEFT; side <= SIM_SIDE_RIGHT; side++) {
+        SimAi *ai = &sim->ai[side];
+        unsigned char bits = (unsigned char)(flags >> (1 + 3 * side));
+        ai->intercept.hasTarget = (bits & 1) != 0;
+        ai->intercept.valid = (bits & 2) != 0;
+        ai->incoming = (bits & 4) != 0;
+
+        ai->profile.reactionTicks = *p++;
+        ai->profile.aimError = SimGetF32(&p);
+        ai->profile.maxSpeed = SimGetF32(&p);
+        ai->profile.maxAccel = SimGetF32(&p);
+        ai->intercept.velocity.x = SimGetF32(&p);
+        ai->intercept.velocity.y = SimGetF32(&p);
+        ai->intercept.y = SimGetF32(&p);
+        ai->velocity = SimGetF32(&p);
+        ai->aimOffset = SimGetF32(&p);
+    }
+    p++;   // depth, read above
+
+    // Slots older than the saved history are never read; give them the
+    // current ball so a restored state doesn't depend on what was there before
+    for (int i = 0; i < SIM_AI_HISTORY; i++) sim->ballHistory[i] = (SimBallSample){ sim->ball.position, sim->ball.velocity };
+    for (int age = depth - 1; age >= 0; age--) {
+        SimBallSample *sample = &sim->ballHistory[(sim->frame - (uint32_t)age) % SIM_AI_HISTORY];
+        sample->position.x = SimGetF32(&p);
+        sample->position.y = SimGetF32(&p);
+        sample->velocity.x = SimGetF32(&p);
+        sample->velocity.y = SimGetF32(&p);
+    }
+
+    return (size_t)(p - data);
+}
@@ -0,0 +1,214 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2025, BISMAYA JYOTI DALEI
+
+See the LICENSE file in the project root for the full license text.
+*/
+
+// Pure game-rules core for PhantomPong.
+//
+// Nothing in here touches raylib, the window or the audio device: the caller
+// fills a SimInput every tick and gets back a list of SimEvents describing
+// what happened (paddle hits, scores, ...), which the front end turns into
+// sounds, particles and screen shake. This lets the same rules run inside the
+// game, in batch tools and in benchmarks on headless machines.
+
+#ifndef PONG_SIM_H
+#define PONG_SIM_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "rng.h"
+
+// Court and physics constants (distances in pixels, speeds in pixels per tick)
+#define SIM_COURT_WIDTH 1280
+#define SIM_COURT_HEIGHT 800
+#define SIM_PADDLE_WIDTH 25
+#define SIM_PADDLE_HEIGHT 200
+#define SIM_PADDLE_MARGIN 10
+#define SIM_BALL_RADIUS 20
+#define SIM_BALL_INITIAL_SPEED 8.0f
+#define SIM_PADDLE_SPEED 12.0f
+#define SIM_MAX_BALL_SPEED 15.0f
+#define SIM_SPEED_INCREMENT 0.2f
+#define SIM_WALL_BOUNCE_BUFFER 2.0f   // Push-out after a wall bounce in the discrete SoA engine
+#define SIM_MAX_CONTACTS 4            // Bounces resolved within a single tick
+#define SIM_DEFAULT_WIN_SCORE 10
+
+// Full-scale value of a SimInput axis
+#define SIM_AXIS_MAX 127
+
+// Maximum number of events a single SimStep can emit
+#define SIM_MAX_EVENTS 8
+
+// Past ball samples kept for AI reaction delay: the power of two above the
+// slowest skill (30 ticks) so the slot is a mask. SimSetAi clamps below this.
+#define SIM_AI_HISTORY 32
+
+// Largest SimSaveState output: the fixed fields plus the deepest history
+#define SIM_SAVE_FIXED_BYTES 172
+#define SIM_SAVE_MAX_BYTES (SIM_SAVE_FIXED_BYTES + (SIM_AI_HISTORY - 1) * 16)
+
+typedef enum {
+    SIM_SIDE_LEFT,   // Player 1
+    SIM_SIDE_RIGHT   // AI or Player 2
+} SimSide;
+
+typedef struct {
+    float x;
+    float y;
+} SimVec2;
+
+typedef struct {
+    float x;
+    float y;
+    float width;
+    float height;
+} SimRect;
+
+typedef struct {
+    SimVec2 position;
+    SimVec2 velocity;
+    float radius;
+} SimBall;
+
+typedef struct {
+    SimRect rect;
+    float speed;
+} SimPaddle;
+
+// What the AI remembers of the ball from one tick (its radius never changes)
+typedef struct {
+    SimVec2 position;
+    SimVec2 velocity;
+} SimBallSample;
+
+// Per-tick controls. Axes run from -SIM_AXIS_MAX (up) to SIM_AXIS_MAX (down)
+// and are ignored for a side that is driven by the built-in AI.
+typedef struct {
+    int8_t axis[2];
+    bool aiControlled[2];
+} SimInput;
+
+typedef enum {
+    SIM_EVENT_PADDLE_HIT,
+    SIM_EVENT_WALL_BOUNCE,
+    SIM_EVENT_SCORE,      // side = scoring side
+    SIM_EVENT_MATCH_OVER  // side = winner
+} SimEventType;
+
+typedef struct {
+    SimEventType type;
+    SimSide side;
+    SimVec2 position;   // Ball position when the event happened
+} SimEvent;
+
+// How a built-in AI plays. Everything is per tick, like the rest of the sim.
+typedef struct {
+    int reactionTicks;   // Age of the ball state the AI reacts to
+    float aimError;      // Largest aim offset in pixels, drawn once per volley
+    float maxSpeed;      // Paddle speed limit, pixels per tick
+    float maxAccel;      // Paddle acceleration limit, pixels per tick per tick
+} SimAiProfile;
+
+// Named difficulty levels. Their profiles are calibrated offline against
+// SimAiReferenceProfile with `pongbatch --calibrate`.
+typedef enum {
+    SIM_AI_EASY,
+    SIM_AI_NORMAL,
+    SIM_AI_HARD,
+    SIM_AI_EXPERT,
+    SIM_AI_TIER_COUNT
+} SimAiTier;
+
+// Where the ball will cross the line of the paddle it is heading for. Only
+// depends on the ball's path, so it is worked out once per velocity change
+// (serve, paddle hit, wall bounce) and reused on every tick in between.
+typedef struct {
+    SimVec2 velocity;   // Ball velocity the prediction was made for
+    float y;            // Predicted ball centre height at contact
+    bool hasTarget;     // False if the ball was already past the contact line
+    bool valid;
+} SimIntercept;
+
+// Per-side AI state
+typedef struct {
+    SimAiProfile profile;
+    SimIntercept intercept;  // Prediction for the ball as this AI last saw it
+    float velocity;          // Paddle velocity, pixels per tick
+    float aimOffset;         // Aim error for the volley in progress
+    bool incoming;           // The ball as seen is heading for this paddle
+} SimAi;
+
+typedef struct {
+    SimBall ball;
+    SimPaddle paddles[2];
+    int scores[2];
+    int winScore;
+    float ballSpeedMultiplier;   // 0.5 to 2.0
+    bool matchOver;
+    uint32_t frame;              // Ticks simulated since SimInit
+    uint64_t seed;               // Seed the match was started with
+    Rng rng;                     // Gameplay stream (serves, AI error)
+    SimAi ai[2];
+    SimBallSample ballHistory[SIM_AI_HISTORY];   // Ball at the start of recent ticks, by frame
+} SimState;
+
+// Reset a match: paddles centred, scores zeroed, left side serving, both AIs
+// at SIM_AI_NORMAL. The same seed and the same sequence of inputs always
+// produce the same match.
+void SimInit(SimState *sim, float ballSpeedMultiplier, int winScore, uint64_t seed);
+
+// Advance one tick. Writes up to SIM_MAX_EVENTS events and returns how many.
+// Does nothing once the match is over.
+int SimStep(SimState *sim, const SimInput *input, SimEvent *events);
+
+// Put the ball back in the centre, travelling towards the receiving side.
+void SimResetBall(SimState *sim, SimSide server);
+
+// Swept ball/paddle test used by SimStep. Returns the fraction of move
+// (0 to 1) at which the ball first touches the paddle, or -1 if it doesn't.
+// Only counts if the ball is travelling towards the paddle; a ball that
+// already overlaps it touches at 0.
+float SimSweepPaddle(const SimBall *ball, SimVec2 move, const SimPaddle *paddle);
+
+// Height the ball centre will be at when it reaches contactX, following its
+// bounces off both walls. Closed form, exact for the path SimStep takes.
+// Returns false (and leaves *y alone) if the ball is moving away from contactX.
+bool SimPredictIntercept(const SimBall *ball, float contactX, float *y);
+
+// Use profile for side's built-in AI (call after SimInit, before the first step)
+void SimSetAi(SimState *sim, SimSide side, const SimAiProfile *profile);
+
+const SimAiProfile *SimAiTierProfile(SimAiTier tier);
+const char *SimAiTierName(SimAiTier tier);
+
+// Look up a tier by name, ignoring ASCII case. Returns false if none matches.
+bool SimAiTierFromName(const char *name, SimAiTier *tier);
+
+// The player model tiers are calibrated against: a typical human with a
+// quarter-second reaction time
+const SimAiProfile *SimAiReferenceProfile(void);
+
+// Profile for a skill level from 0 (slowest, sloppiest) to 1 (sharpest).
+// Calibration searches along this line; the tier table stores its results.
+SimAiProfile SimAiProfileFromSkill(float skill);
+
+// Move an AI-controlled paddle one tick towards the predicted intercept.
+void SimUpdateAI(SimState *sim, SimSide side);
+
+// Serialise sim field by field (little-endian, no padding) into out, which
+// must hold SIM_SAVE_MAX_BYTES (SIM_SAVE_FIXED_BYTES if neither side is
+// AI-controlled). Only as much ball history is kept as the
+// AI-controlled sides will still read, so a state with no AI side is
+// SIM_SAVE_FIXED_BYTES. Returns the number of bytes written.
+size_t SimSaveState(const SimState *sim, const bool aiControlled[2], unsigned char *out);
+
+// Restore a state written by SimSaveState. History older than what was
+// saved is filled in but must not be read: keep the same sides AI-controlled.
+// Returns the number of bytes read, or 0 if data is truncated or malformed.
+size_t SimLoadState(SimState *sim, const unsigned char *data, size_t size);
+
+#endif // PONG_SIM_H
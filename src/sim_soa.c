@@ -0,0 +1,501 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2025, BISMAYA JYOTI DALEI
+
+See the LICENSE file in the project root for the full license text.
+*/
+
+#include "sim_soa.h"
+#include "sim.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if SIM_SOA_LANES > 1
+#include <immintrin.h>
+#endif
+
+#define SOA_ALIGNMENT 64
+#define SOA_FIELD_COUNT 12
+
+// Court geometry shared by every lane
+#define LEFT_PADDLE_X ((float)SIM_PADDLE_MARGIN)
+#define RIGHT_PADDLE_X ((float)(SIM_COURT_WIDTH - SIM_PADDLE_MARGIN - SIM_PADDLE_WIDTH))
+#define PADDLE_MAX_Y ((float)(SIM_COURT_HEIGHT - SIM_PADDLE_HEIGHT))
+
+// Per-run constants derived from the speed multiplier
+typedef struct {
+    float difficulty;
+    float noiseScale;       // 1 - difficulty
+    float noiseThreshold;   // AI adds noise when a draw in [0, 101) lands below this
+    float maxStep;
+    float maxSpeed;
+    float initialSpeed;
+} SoAParams;
+
+static SoAParams MakeParams(float speedMultiplier) {
+    SoAParams params;
+    float difficulty = 0.7f * (1.0f + (speedMultiplier - 1.0f) * 0.5f);
+    difficulty = fminf(fmaxf(difficulty, 0.5f), 0.95f);
+    params.difficulty = difficulty;
+    params.noiseScale = 1.0f - difficulty;
+    params.noiseThreshold = (float)(int)(30 * (1.0f - difficulty));
+    params.maxStep = SIM_PADDLE_SPEED * difficulty;
+    params.maxSpeed = SIM_MAX_BALL_SPEED * speedMultiplier;
+    params.initialSpeed = SIM_BALL_INITIAL_SPEED * speedMultiplier;
+    return params;
+}
+
+//----------------------------------------------------------------------------------
+// Scalar lane kernel. Also the reference the SIMD kernels must match bit for bit.
+//----------------------------------------------------------------------------------
+
+static uint32_t NextRandom(uint32_t *state) {
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+// Uniform float in [0, 1) from the top 24 bits
+static float RandomUnit(uint32_t bits) {
+    return (float)(int32_t)(bits >> 8) * (1.0f / 16777216.0f);
+}
+
+// Reflect a predicted ball centre back into [r, H - r] as if bouncing off
+// both walls, the same closed form as SimPredictIntercept
+#define FOLD_SPAN ((float)(SIM_COURT_HEIGHT - 2 * SIM_BALL_RADIUS))
+
+static float FoldIntoCourt(float y) {
+    const float period = 2.0f * FOLD_SPAN;
+    float u = y - SIM_BALL_RADIUS;
+    float m = u - period * floorf(u / period);
+    return SIM_BALL_RADIUS + ((m > FOLD_SPAN) ? period - m : m);
+}
+
+static float ScalarAI(float paddleY, float face, float direction, float bx, float by, float vx, float vy,
+                      uint32_t *rng, const SoAParams *params) {
+    float predicted = by;
+    if (vx * direction > 0) {
+        float t = (face - bx) / vx;
+        if (t > 0) predicted = FoldIntoCourt(by + vy * t);
+    }
+
+    float target = predicted - SIM_PADDLE_HEIGHT / 2;
+
+    // Both draws happen every tick so all lanes stay in step
+    float roll = floorf(RandomUnit(NextRandom(rng)) * 101.0f);
+    float offset = floorf(RandomUnit(NextRandom(rng)) * 61.0f) - 30.0f;
+    if (roll < params->noiseThreshold) target += offset * params->noiseScale;
+
+    target = fminf(fmaxf(target, 0.0f), PADDLE_MAX_Y);
+
+    float distance = target - paddleY;
+    if (fabsf(distance) > 1.0f) {
+        float step = distance * 0.1f * params->difficulty;
+        step = fminf(fmaxf(step, -params->maxStep), params->maxStep);
+        paddleY += step;
+    }
+
+    return fminf(fmaxf(paddleY, 0.0f), PADDLE_MAX_Y);
+}
+
+static void StepLaneScalar(SimSoA *soa, int i, const SoAParams *params) {
+    if (soa->done[i]) return;
+    soa->frames[i]++;
+
+    float bx = soa->ballX[i], by = soa->ballY[i];
+    float vx = soa->ballVX[i], vy = soa->ballVY[i];
+    const float r = SIM_BALL_RADIUS;
+
+    // The AI aims where the ball centre will be one radius out from each face
+    soa->paddleY[SIM_SIDE_LEFT][i] = ScalarAI(soa->paddleY[SIM_SIDE_LEFT][i], LEFT_PADDLE_X + SIM_PADDLE_WIDTH + r,
+                                              -1.0f, bx, by, vx, vy, &soa->rng[i], params);
+    soa->paddleY[SIM_SIDE_RIGHT][i] = ScalarAI(soa->paddleY[SIM_SIDE_RIGHT][i], RIGHT_PADDLE_X - r,
+                                               1.0f, bx, by, vx, vy, &soa->rng[i], params);
+
+    bx += vx;
+    by += vy;
+
+    // Walls
+    if (by - r <= 0 || by + r >= SIM_COURT_HEIGHT) {
+        vy = -vy;
+        if (by < r) by = r + SIM_WALL_BOUNCE_BUFFER;
+        if (by > SIM_COURT_HEIGHT - r) by = SIM_COURT_HEIGHT - r - SIM_WALL_BOUNCE_BUFFER;
+    }
+
+    // Paddles: a point-in-box test on the paddle grown by 2r horizontally and
+    // r vertically, the discrete overlap check SimStep used before sweeping
+    for (int side = SIM_SIDE_LEFT; side <= SIM_SIDE_RIGHT; side++) {
+        float px = (side == SIM_SIDE_LEFT) ? LEFT_PADDLE_X : RIGHT_PADDLE_X;
+        float py = soa->paddleY[side][i];
+        bool toward = (side == SIM_SIDE_LEFT) ? (vx < 0) : (vx > 0);
+        bool inside = bx >= px - 2 * r && bx <= px + SIM_PADDLE_WIDTH + 2 * r &&
+                      by >= py - r && by <= py + SIM_PADDLE_HEIGHT + r;
+        if (toward && inside) {
+            float hit = (by - (py + SIM_PADDLE_HEIGHT / 2)) / (SIM_PADDLE_HEIGHT / 2);
+            float speed = fminf(fabsf(vx) + SIM_SPEED_INCREMENT, params->maxSpeed);
+            vx = (side == SIM_SIDE_LEFT) ? speed : -speed;
+            vy = hit * (speed * 0.75f);
+        }
+    }
+
+    // Scoring and serve
+    bool leftMissed = bx < -SIM_BALL_RADIUS;
+    bool rightMissed = bx > SIM_COURT_WIDTH + SIM_BALL_RADIUS;
+    if (leftMissed || rightMissed) {
+        soa->scores[leftMissed ? SIM_SIDE_RIGHT : SIM_SIDE_LEFT][i]++;
+        float angle = (floorf(RandomUnit(NextRandom(&soa->rng[i])) * 201.0f) - 100.0f) / 100.0f;
+        bx = SIM_COURT_WIDTH / 2;
+        by = SIM_COURT_HEIGHT / 2;
+        vx = leftMissed ? -params->initialSpeed : params->initialSpeed;
+        vy = angle * params->initialSpeed;
+    }
+
+    soa->ballX[i] = bx;
+    soa->ballY[i] = by;
+    soa->ballVX[i] = vx;
+    soa->ballVY[i] = vy;
+
+    if (soa->scores[SIM_SIDE_LEFT][i] >= soa->winScore || soa->scores[SIM_SIDE_RIGHT][i] >= soa->winScore) {
+        soa->done[i] = -1;
+    }
+}
+
+//----------------------------------------------------------------------------------
+// SIMD kernels. One body, written against a thin macro layer, compiled as AVX2
+// or SSE2. Every branch in the scalar kernel becomes a compare + blend.
+//----------------------------------------------------------------------------------
+
+#if SIM_SOA_LANES == 8
+
+typedef __m256 vf;
+typedef __m256i vi;
+#define VF_SET1(x)        _mm256_set1_ps(x)
+#define VF_LOAD(p)        _mm256_load_ps(p)
+#define VF_STORE(p, v)    _mm256_store_ps((p), (v))
+#define VI_LOAD(p)        _mm256_load_si256((const __m256i *)(p))
+#define VI_STORE(p, v)    _mm256_store_si256((__m256i *)(p), (v))
+#define VF_ADD            _mm256_add_ps
+#define VF_SUB            _mm256_sub_ps
+#define VF_MUL            _mm256_mul_ps
+#define VF_DIV            _mm256_div_ps
+#define VF_MIN            _mm256_min_ps
+#define VF_MAX            _mm256_max_ps
+#define VF_AND            _mm256_and_ps
+#define VF_OR             _mm256_or_ps
+#define VF_ANDNOT         _mm256_andnot_ps
+#define VF_LT(a, b)       _mm256_cmp_ps((a), (b), _CMP_LT_OQ)
+#define VF_LE(a, b)       _mm256_cmp_ps((a), (b), _CMP_LE_OQ)
+#define VF_GT(a, b)       _mm256_cmp_ps((a), (b), _CMP_GT_OQ)
+#define VF_GE(a, b)       _mm256_cmp_ps((a), (b), _CMP_GE_OQ)
+#define VF_BLEND(a, b, m) _mm256_blendv_ps((a), (b), (m))
+#define VF_FLOOR(a)       _mm256_floor_ps(a)
+#define VF_FROM_VI(a)     _mm256_cvtepi32_ps(a)
+#define VF_AS_VI(a)       _mm256_castps_si256(a)
+#define VI_AS_VF(a)       _mm256_castsi256_ps(a)
+#define VI_SET1(x)        _mm256_set1_epi32(x)
+#define VI_ADD            _mm256_add_epi32
+#define VI_SUB            _mm256_sub_epi32
+#define VI_XOR            _mm256_xor_si256
+#define VI_SHL(a, n)      _mm256_slli_epi32((a), (n))
+#define VI_SHR(a, n)      _mm256_srli_epi32((a), (n))
+#define VI_GE(a, b)       _mm256_or_si256(_mm256_cmpgt_epi32((a), (b)), _mm256_cmpeq_epi32((a), (b)))
+#define VF_MOVEMASK(a)    _mm256_movemask_ps(a)
+#define VF_ALL_MASK       0xFF
+
+#elif SIM_SOA_LANES == 4
+
+typedef __m128 vf;
+typedef __m128i vi;
+#define VF_SET1(x)        _mm_set1_ps(x)
+#define VF_LOAD(p)        _mm_load_ps(p)
+#define VF_STORE(p, v)    _mm_store_ps((p), (v))
+#define VI_LOAD(p)        _mm_load_si128((const __m128i *)(p))
+#define VI_STORE(p, v)    _mm_store_si128((__m128i *)(p), (v))
+#define VF_ADD            _mm_add_ps
+#define VF_SUB            _mm_sub_ps
+#define VF_MUL            _mm_mul_ps
+#define VF_DIV            _mm_div_ps
+#define VF_MIN            _mm_min_ps
+#define VF_MAX            _mm_max_ps
+#define VF_AND            _mm_and_ps
+#define VF_OR             _mm_or_ps
+#define VF_ANDNOT         _mm_andnot_ps
+#define VF_LT             _mm_cmplt_ps
+#define VF_LE             _mm_cmple_ps
+#define VF_GT             _mm_cmpgt_ps
+#define VF_GE             _mm_cmpge_ps
+#define VF_BLEND(a, b, m) _mm_or_ps(_mm_and_ps((m), (b)), _mm_andnot_ps((m), (a)))
+#define VF_FROM_VI(a)     _mm_cvtepi32_ps(a)
+#define VF_AS_VI(a)       _mm_castps_si128(a)
+#define VI_AS_VF(a)       _mm_castsi128_ps(a)
+#define VI_SET1(x)        _mm_set1_epi32(x)
+#define VI_ADD            _mm_add_epi32
+#define VI_SUB            _mm_sub_epi32
+#define VI_XOR            _mm_xor_si128
+#define VI_SHL(a, n)      _mm_slli_epi32((a), (n))
+#define VI_SHR(a, n)      _mm_srli_epi32((a), (n))
+#define VI_GE(a, b)       _mm_or_si128(_mm_cmpgt_epi32((a), (b)), _mm_cmpeq_epi32((a), (b)))
+#define VF_MOVEMASK(a)    _mm_movemask_ps(a)
+#define VF_ALL_MASK       0xF
+
+// SSE2 has no round instruction: truncate, then step down where that rounded up
+static inline vf VF_FLOOR(vf a) {
+    vf truncated = _mm_cvtepi32_ps(_mm_cvttps_epi32(a));
+    return _mm_sub_ps(truncated, _mm_and_ps(_mm_cmpgt_ps(truncated, a), _mm_set1_ps(1.0f)));
+}
+
+#endif
+
+#if SIM_SOA_LANES > 1
+
+static inline vf VF_ABS(vf a) {
+    return VF_ANDNOT(VF_SET1(-0.0f), a);
+}
+
+static inline vf VF_CLAMP(vf a, vf lo, vf hi) {
+    return VF_MIN(VF_MAX(a, lo), hi);
+}
+
+static inline vi NextRandomV(vi *state) {
+    vi x = *state;
+    x = VI_XOR(x, VI_SHL(x, 13));
+    x = VI_XOR(x, VI_SHR(x, 17));
+    x = VI_XOR(x, VI_SHL(x, 5));
+    *state = x;
+    return x;
+}
+
+static inline vf RandomUnitV(vi bits) {
+    return VF_MUL(VF_FROM_VI(VI_SHR(bits, 8)), VF_SET1(1.0f / 16777216.0f));
+}
+
+static inline vf FoldIntoCourtV(vf y) {
+    const vf period = VF_SET1(2.0f * FOLD_SPAN);
+    const vf radius = VF_SET1((float)SIM_BALL_RADIUS);
+    vf u = VF_SUB(y, radius);
+    vf m = VF_SUB(u, VF_MUL(period, VF_FLOOR(VF_DIV(u, period))));
+    return VF_ADD(radius, VF_BLEND(m, VF_SUB(period, m), VF_GT(m, VF_SET1(FOLD_SPAN))));
+}
+
+static inline vf SimdAI(vf paddleY, float face, float direction, vf bx, vf by, vf vx, vf vy,
+                        vi *rng, const SoAParams *params) {
+    const vf zero = VF_SET1(0.0f);
+
+    vf t = VF_DIV(VF_SUB(VF_SET1(face), bx), vx);
+    vf predictMask = VF_AND(VF_GT(VF_MUL(vx, VF_SET1(direction)), zero), VF_GT(t, zero));
+    vf predicted = VF_BLEND(by, FoldIntoCourtV(VF_ADD(by, VF_MUL(vy, t))), predictMask);
+
+    vf target = VF_SUB(predicted, VF_SET1(SIM_PADDLE_HEIGHT / 2));
+
+    vf roll = VF_FLOOR(VF_MUL(RandomUnitV(NextRandomV(rng)), VF_SET1(101.0f)));
+    vf offset = VF_SUB(VF_FLOOR(VF_MUL(RandomUnitV(NextRandomV(rng)), VF_SET1(61.0f))), VF_SET1(30.0f));
+    vf noisy = VF_ADD(target, VF_MUL(offset, VF_SET1(params->noiseScale)));
+    target = VF_BLEND(target, noisy, VF_LT(roll, VF_SET1(params->noiseThreshold)));
+
+    target = VF_CLAMP(target, zero, VF_SET1(PADDLE_MAX_Y));
+
+    vf distance = VF_SUB(target, paddleY);
+    vf step = VF_MUL(VF_MUL(distance, VF_SET1(0.1f)), VF_SET1(params->difficulty));
+    step = VF_CLAMP(step, VF_SET1(-params->maxStep), VF_SET1(params->maxStep));
+    vf moved = VF_ADD(paddleY, step);
+    paddleY = VF_BLEND(paddleY, moved, VF_GT(VF_ABS(distance), VF_SET1(1.0f)));
+
+    return VF_CLAMP(paddleY, zero, VF_SET1(PADDLE_MAX_Y));
+}
+
+static void StepBlockSimd(SimSoA *soa, int i, const SoAParams *params) {
+    const vf r = VF_SET1(SIM_BALL_RADIUS);
+    const vf zero = VF_SET1(0.0f);
+    const vf courtHeight = VF_SET1((float)SIM_COURT_HEIGHT);
+
+    vf done = VI_AS_VF(VI_LOAD(&soa->done[i]));
+    if (VF_MOVEMASK(done) == VF_ALL_MASK) return;
+
+    vf bx = VF_LOAD(&soa->ballX[i]);
+    vf by = VF_LOAD(&soa->ballY[i]);
+    vf vx = VF_LOAD(&soa->ballVX[i]);
+    vf vy = VF_LOAD(&soa->ballVY[i]);
+    vf leftY = VF_LOAD(&soa->paddleY[SIM_SIDE_LEFT][i]);
+    vf rightY = VF_LOAD(&soa->paddleY[SIM_SIDE_RIGHT][i]);
+    vi rng = VI_LOAD(&soa->rng[i]);
+    vi leftScore = VI_LOAD(&soa->scores[SIM_SIDE_LEFT][i]);
+    vi rightScore = VI_LOAD(&soa->scores[SIM_SIDE_RIGHT][i]);
+
+    vf newLeftY = SimdAI(leftY, LEFT_PADDLE_X + SIM_PADDLE_WIDTH + SIM_BALL_RADIUS, -1.0f,
+                         bx, by, vx, vy, &rng, params);
+    vf newRightY = SimdAI(rightY, RIGHT_PADDLE_X - SIM_BALL_RADIUS, 1.0f, bx, by, vx, vy, &rng, params);
+
+    vf nbx = VF_ADD(bx, vx);
+    vf nby = VF_ADD(by, vy);
+
+    // Walls
+    vf wallMask = VF_OR(VF_LE(VF_SUB(nby, r), zero), VF_GE(VF_ADD(nby, r), courtHeight));
+    vy = VF_BLEND(vy, VF_SUB(zero, vy), wallMask);
+    nby = VF_BLEND(nby, VF_SET1(SIM_BALL_RADIUS + SIM_WALL_BOUNCE_BUFFER), VF_AND(wallMask, VF_LT(nby, r)));
+    nby = VF_BLEND(nby, VF_SET1(SIM_COURT_HEIGHT - SIM_BALL_RADIUS - SIM_WALL_BOUNCE_BUFFER),
+                   VF_AND(wallMask, VF_GT(nby, VF_SUB(courtHeight, r))));
+
+    // Paddles
+    for (int side = SIM_SIDE_LEFT; side <= SIM_SIDE_RIGHT; side++) {
+        float px = (side == SIM_SIDE_LEFT) ? LEFT_PADDLE_X : RIGHT_PADDLE_X;
+        vf py = (side == SIM_SIDE_LEFT) ? newLeftY : newRightY;
+        vf toward = (side == SIM_SIDE_LEFT) ? VF_LT(vx, zero) : VF_GT(vx, zero);
+        vf inside = VF_AND(VF_AND(VF_GE(nbx, VF_SET1(px - 2 * SIM_BALL_RADIUS)),
+                                  VF_LE(nbx, VF_SET1(px + SIM_PADDLE_WIDTH + 2 * SIM_BALL_RADIUS))),
+                           VF_AND(VF_GE(nby, VF_SUB(py, r)),
+                                  VF_LE(nby, VF_ADD(py, VF_SET1(SIM_PADDLE_HEIGHT + SIM_BALL_RADIUS)))));
+        vf hitMask = VF_AND(toward, inside);
+
+        vf hit = VF_DIV(VF_SUB(nby, VF_ADD(py, VF_SET1(SIM_PADDLE_HEIGHT / 2))), VF_SET1(SIM_PADDLE_HEIGHT / 2));
+        vf speed = VF_MIN(VF_ADD(VF_ABS(vx), VF_SET1(SIM_SPEED_INCREMENT)), VF_SET1(params->maxSpeed));
+        vf newVX = (side == SIM_SIDE_LEFT) ? speed : VF_SUB(zero, speed);
+        vx = VF_BLEND(vx, newVX, hitMask);
+        vy = VF_BLEND(vy, VF_MUL(hit, VF_MUL(speed, VF_SET1(0.75f))), hitMask);
+    }
+
+    // Scoring and serve. The serve draw only advances the lanes that scored.
+    vf leftMissed = VF_LT(nbx, VF_SET1(-SIM_BALL_RADIUS));
+    vf rightMissed = VF_GT(nbx, VF_SET1(SIM_COURT_WIDTH + SIM_BALL_RADIUS));
+    vf scored = VF_OR(leftMissed, rightMissed);
+    rightScore = VI_SUB(rightScore, VF_AS_VI(leftMissed));   // mask lanes are -1
+    leftScore = VI_SUB(leftScore, VF_AS_VI(rightMissed));
+
+    vi servedRng = rng;
+    vf angle = VF_DIV(VF_SUB(VF_FLOOR(VF_MUL(RandomUnitV(NextRandomV(&servedRng)), VF_SET1(201.0f))),
+                             VF_SET1(100.0f)), VF_SET1(100.0f));
+    rng = VF_AS_VI(VF_BLEND(VI_AS_VF(rng), VI_AS_VF(servedRng), scored));
+
+    nbx = VF_BLEND(nbx, VF_SET1(SIM_COURT_WIDTH / 2), scored);
+    nby = VF_BLEND(nby, VF_SET1(SIM_COURT_HEIGHT / 2), scored);
+    vf serveVX = VF_BLEND(VF_SET1(params->initialSpeed), VF_SET1(-params->initialSpeed), leftMissed);
+    vx = VF_BLEND(vx, serveVX, scored);
+    vy = VF_BLEND(vy, VF_MUL(angle, VF_SET1(params->initialSpeed)), scored);
+
+    // Finished lanes keep their old state untouched
+    vf live = VF_ANDNOT(done, VI_AS_VF(VI_SET1(-1)));
+    VF_STORE(&soa->ballX[i], VF_BLEND(bx, nbx, live));
+    VF_STORE(&soa->ballY[i], VF_BLEND(by, nby, live));
+    VF_STORE(&soa->ballVX[i], VF_BLEND(VF_LOAD(&soa->ballVX[i]), vx, live));
+    VF_STORE(&soa->ballVY[i], VF_BLEND(VF_LOAD(&soa->ballVY[i]), vy, live));
+    VF_STORE(&soa->paddleY[SIM_SIDE_LEFT][i], VF_BLEND(leftY, newLeftY, live));
+    VF_STORE(&soa->paddleY[SIM_SIDE_RIGHT][i], VF_BLEND(rightY, newRightY, live));
+    VI_STORE(&soa->rng[i], VF_AS_VI(VF_BLEND(VI_AS_VF(VI_LOAD(&soa->rng[i])), VI_AS_VF(rng), live)));
+
+    vi oldLeft = VI_LOAD(&soa->scores[SIM_SIDE_LEFT][i]);
+    vi oldRight = VI_LOAD(&soa->scores[SIM_SIDE_RIGHT][i]);
+    leftScore = VF_AS_VI(VF_BLEND(VI_AS_VF(oldLeft), VI_AS_VF(leftScore), live));
+    rightScore = VF_AS_VI(VF_BLEND(VI_AS_VF(oldRight), VI_AS_VF(rightScore), live));
+    VI_STORE(&soa->scores[SIM_SIDE_LEFT][i], leftScore);
+    VI_STORE(&soa->scores[SIM_SIDE_RIGHT][i], rightScore);
+
+    vi frames = VI_LOAD(&soa->frames[i]);
+    VI_STORE(&soa->frames[i], VI_SUB(frames, VF_AS_VI(live)));
+
+    vi winScore = VI_SET1(soa->winScore);
+    vf finished = VF_OR(VI_AS_VF(VI_GE(leftScore, winScore)), VI_AS_VF(VI_GE(rightScore, winScore)));
+    VI_STORE(&soa->done[i], VF_AS_VI(VF_OR(done, finished)));
+}
+
+#endif // SIM_SOA_LANES > 1
+
+//----------------------------------------------------------------------------------
+// Public API
+//----------------------------------------------------------------------------------
+
+int SimSoAInit(SimSoA *soa, int count, float ballSpeedMultiplier, int winScore, uint32_t seed) {
+    memset(soa, 0, sizeof(*soa));
+    if (count <= 0) return -1;
+
+    int capacity = (count + SIM_SOA_LANES - 1) / SIM_SOA_LANES * SIM_SOA_LANES;
+    size_t fieldBytes = ((size_t)capacity * 4 + SOA_ALIGNMENT - 1) / SOA_ALIGNMENT * SOA_ALIGNMENT;
+
+    soa->memory = malloc(fieldBytes * SOA_FIELD_COUNT + SOA_ALIGNMENT);
+    if (soa->memory == NULL) return -1;
+
+    unsigned char *base = (unsigned char *)(((uintptr_t)soa->memory + SOA_ALIGNMENT - 1) & ~(uintptr_t)(SOA_ALIGNMENT - 1));
+    memset(base, 0, fieldBytes * SOA_FIELD_COUNT);
+
+    void **fields[SOA_FIELD_COUNT] = {
+        (void **)&soa->ballX, (void **)&soa->ballY, (void **)&soa->ballVX, (void **)&soa->ballVY,
+        (void **)&soa->paddleY[0], (void **)&soa->paddleY[1],
+        (void **)&soa->scores[0], (void **)&soa->scores[1],
+        (void **)&soa->done, (void **)&soa->rng, (void **)&soa->frames, NULL
+    };
+    for (int f = 0; f < SOA_FIELD_COUNT && fields[f] != NULL; f++) {
+        *fields[f] = base + fieldBytes * (size_t)f;
+    }
+
+    soa->count = count;
+    soa->capacity = capacity;
+    soa->speedMultiplier = ballSpeedMultiplier;
+    soa->winScore = winScore;
+
+    SoAParams params = MakeParams(ballSpeedMultiplier);
+    uint32_t laneSeed = seed ? seed : 0x9E3779B9u;
+
+    for (int i = 0; i < capacity; i++) {
+        laneSeed = laneSeed * 1664525u + 1013904223u;
+        soa->rng[i] = laneSeed | 1u;
+
+        float angle = (floorf(RandomUnit(NextRandom(&soa->rng[i])) * 201.0f) - 100.0f) / 100.0f;
+        soa->ballX[i] = SIM_COURT_WIDTH / 2;
+        soa->ballY[i] = SIM_COURT_HEIGHT / 2;
+        soa->ballVX[i] = params.initialSpeed;   // Left side serves first
+        soa->ballVY[i] = angle * params.initialSpeed;
+        soa->paddleY[SIM_SIDE_LEFT][i] = PADDLE_MAX_Y / 2;
+        soa->paddleY[SIM_SIDE_RIGHT][i] = PADDLE_MAX_Y / 2;
+
+        // Padding lanes start finished so they never count as running
+        soa->done[i] = (i < count) ? 0 : -1;
+    }
+
+    return 0;
+}
+
+void SimSoAFree(SimSoA *soa) {
+    free(soa->memory);
+    memset(soa, 0, sizeof(*soa));
+}
+
+static int CountRunning(const SimSoA *soa) {
+    int running = 0;
+    for (int i = 0; i < soa->count; i++) {
+        running += (soa->done[i] == 0);
+    }
+    return running;
+}
+
+int SimSoAStep(SimSoA *soa) {
+#if SIM_SOA_LANES > 1
+    SoAParams params = MakeParams(soa->speedMultiplier);
+    for (int i = 0; i < soa->capacity; i += SIM_SOA_LANES) {
+        StepBlockSimd(soa, i, &params);
+    }
+    return CountRunning(soa);
+#else
+    return SimSoAStepScalar(soa);
+#endif
+}
+
+int SimSoAStepScalar(SimSoA *soa) {
+    SoAParams params = MakeParams(soa->speedMultiplier);
+    for (int i = 0; i < soa->capacity; i++) {
+        StepLaneScalar(soa, i, &params);
+    }
+    return CountRunning(soa);
+}
+
+const char *SimSoAKernelName(void) {
+#if SIM_SOA_LANES == 8
+    return "avx2";
+#elif SIM_SOA_LANES == 4
+    return "sse2";
+#else
+    return "scalar";
+#endif
+}
@@ -0,0 +1,70 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2025, BISMAYA JYOTI DALEI
+
+See the LICENSE file in the project root for the full license text.
+*/
+
+// Structure-of-arrays engine that steps many AI-vs-AI matches in lockstep.
+//
+// Every field lives in its own lane-aligned array so a tick is a handful of
+// AVX2 (8 lanes) or SSE2 (4 lanes) kernels with branches turned into masks.
+// Build with -mavx2 to get the 8-wide path; without any SIMD support it falls
+// back to a scalar loop over the same arrays.
+//
+// This is a simpler game than SimStep, not a port of it. It shares the court
+// size and speed constants, but contact is the cheap end-of-tick overlap test
+// instead of SimStep's swept contact, and the AI is the original
+// single-difficulty one (fresh aim noise every tick, no reaction delay, no
+// cached intercept) instead of the calibrated tiers. Lanes also use their own
+// random streams. Its match outcomes don't match SimStep's, and its
+// throughput only compares with its own scalar path: `pongbatch --soa`
+// reports speedups against that and shows SimStep for scale only.
+
+#ifndef PONG_SIM_SOA_H
+#define PONG_SIM_SOA_H
+
+#include <stdint.h>
+
+#if defined(__AVX2__)
+#define SIM_SOA_LANES 8
+#elif defined(__SSE2__) || defined(_M_X64)
+#define SIM_SOA_LANES 4
+#else
+#define SIM_SOA_LANES 1
+#endif
+
+typedef struct {
+    int count;           // Matches in use
+    int capacity;        // count rounded up to a whole number of lanes
+    float speedMultiplier;
+    int winScore;
+
+    float *ballX;
+    float *ballY;
+    float *ballVX;
+    float *ballVY;
+    float *paddleY[2];   // rect.y of each paddle, indexed by SimSide
+    int32_t *scores[2];
+    int32_t *done;       // All bits set once a lane's match is over
+    uint32_t *rng;
+    uint32_t *frames;    // Ticks simulated per lane
+    void *memory;        // Backing allocation for all of the above
+} SimSoA;
+
+// Allocate and start count matches. Returns 0 on success, -1 on allocation failure.
+int SimSoAInit(SimSoA *soa, int count, float ballSpeedMultiplier, int winScore, uint32_t seed);
+void SimSoAFree(SimSoA *soa);
+
+// Advance every unfinished match by one tick. Returns the number still running.
+int SimSoAStep(SimSoA *soa);
+
+// Same tick one lane at a time. Reference for the SIMD kernels, and the
+// baseline they are measured against.
+int SimSoAStepScalar(SimSoA *soa);
+
+// Name of the kernel compiled in ("avx2", "sse2" or "scalar")
+const char *SimSoAKernelName(void);
+
+#endif // PONG_SIM_SOA_H
@@ -0,0 +1,156 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2025, BISMAYA JYOTI DALEI
+
+See the LICENSE file in the project root for the full license text.
+*/
+
+#include "textcache.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TEXT_LINE_SPACING 2   // raylib's default for multi-line DrawTextEx
+
+typedef struct {
+    Rectangle source;   // In the font atlas
+    Rectangle dest;     // Relative to the text origin
+} GlyphQuad;
+
+typedef struct {
+    bool used;
+    uint32_t hash;
+    unsigned int textureId;
+    int baseSize;
+    float fontSize;
+    float spacing;
+    char *text;
+    Vector2 size;
+    GlyphQuad *quads;
+    int quadCount;
+} TextLayout;
+
+static TextLayout layouts[TEXT_CACHE_SLOTS];
+static int layoutCount;
+
+static uint32_t HashLayout(const char *text, unsigned int textureId, float fontSize, float spacing) {
+    uint32_t hash = 2166136261u;
+    for (const unsigned char *p = (const unsigned char *)text; *p != '\0'; p++) {
+        hash = (hash ^ *p) * 16777619u;
+    }
+    uint32_t bits[3] = { textureId, 0, 0 };
+    memcpy(&bits[1], &fontSize, sizeof(float));
+    memcpy(&bits[2], &spacing, sizeof(float));
+    for (int i = 0; i < 3; i++) hash = (hash ^ bits[i]) * 16777619u;
+    return hash;
+}
+
+// Glyph placement exactly as DrawTextEx / DrawTextCodepoint do it
+static void BuildLayout(TextLayout *layout, Font font, const char *text) {
+    int length = TextLength(text);
+    layout->quads = malloc(sizeof(GlyphQuad) * (size_t)(length > 0 ? length : 1));
+    layout->quadCount = 0;
+    layout->size = MeasureTextEx(font, text, layout->fontSize, layout->spacing);
+
+    float scale = layout->fontSize / font.baseSize;
+    float padding = (float)font.glyphPadding;
+    float offsetX = 0.0f;
+    float offsetY = 0.0f;
+
+    for (int i = 0; i < length;) {
+        int byteCount = 0;
+        int codepoint = GetCodepointNext(&text[i], &byteCount);
+        int index = GetGlyphIndex(font, codepoint);
+        i += byteCount;
+
+        if (codepoint == '\n') {
+            offsetY += layout->fontSize + TEXT_LINE_SPACING;
+            offsetX = 0.0f;
+            continue;
+        }
+
+        Rectangle rec = font.recs[index];
+        GlyphInfo glyph = font.glyphs[index];
+        if (codepoint != ' ' && codepoint != '\t' && layout->quads != NULL) {
+            layout->quads[layout->quadCount++] = (GlyphQuad){
+                .source = { rec.x - padding, rec.y - padding, rec.width + 2.0f * padding, rec.height + 2.0f * padding },
+                .dest = {
+                    offsetX + glyph.offsetX * scale - padding * scale,
+                    offsetY + glyph.offsetY * scale - padding * scale,
+                    (rec.width + 2.0f * padding) * scale,
+                    (rec.height + 2.0f * padding) * scale
+                }
+            };
+        }
+
+        float advance = (glyph.advanceX == 0) ? rec.width : (float)glyph.advanceX;
+        offsetX += advance * scale + layout->spacing;
+    }
+}
+
+static const TextLayout *FindLayout(Font font, const char *text, float fontSize, float spacing) {
+    if (font.texture.id == 0) font = GetFontDefault();
+
+    uint32_t hash = HashLayout(text, font.texture.id, fontSize, spacing);
+    unsigned int slot = hash & (TEXT_CACHE_SLOTS - 1);
+    while (layouts[slot].used) {
+        TextLayout *layout = &layouts[slot];
+        if (layout->hash == hash && layout->textureId == font.texture.id && layout->baseSize == font.baseSize &&
+            layout->fontSize == fontSize && layout->spacing == spacing && strcmp(layout->text, text) == 0) {
+            return layout;
+        }
+        slot = (slot + 1) & (TEXT_CACHE_SLOTS - 1);
+    }
+
+    // Miss: start over rather than let probing degrade (the working set is
+    // a few dozen strings, so this only happens if something is churning)
+    if (layoutCount >= TEXT_CACHE_SLOTS * 3 / 4) {
+        TextCacheClear();
+        slot = hash & (TEXT_CACHE_SLOTS - 1);
+    }
+
+    TextLayout *layout = &layouts[slot];
+    size_t textSize = strlen(text) + 1;
+    layout->text = malloc(textSize);
+    if (layout->text == NULL) return NULL;
+    memcpy(layout->text, text, textSize);
+    layout->used = true;
+    layout->hash = hash;
+    layout->textureId = font.texture.id;
+    layout->baseSize = font.baseSize;
+    layout->fontSize = fontSize;
+    layout->spacing = spacing;
+    BuildLayout(layout, font, text);
+    layoutCount++;
+    return layout;
+}
+
+Vector2 TextCacheMeasure(Font font, const char *text, float fontSize, float spacing) {
+    const TextLayout *layout = FindLayout(font, text, fontSize, spacing);
+    return (layout != NULL) ? layout->size : MeasureTextEx(font, text, fontSize, spacing);
+}
+
+void TextCacheDraw(Font font, const char *text, Vector2 position, float fontSize, float spacing, Color tint) {
+    const TextLayout *layout = FindLayout(font, text, fontSize, spacing);
+    if (layout == NULL || layout->quads == NULL) {
+        DrawTextEx(font, text, position, fontSize, spacing, tint);
+        return;
+    }
+
+    if (font.texture.id == 0) font = GetFontDefault();
+    for (int i = 0; i < layout->quadCount; i++) {
+        const GlyphQuad *quad = &layout->quads[i];
+        Rectangle dest = { position.x + quad->dest.x, position.y + quad->dest.y, quad->dest.width, quad->dest.height };
+        DrawTexturePro(font.texture, quad->source, dest, (Vector2){ 0, 0 }, 0.0f, tint);
+    }
+}
+
+void TextCacheClear(void) {
+    for (int i = 0; i < TEXT_CACHE_SLOTS; i++) {
+        free(layouts[i].text);
+        free(layouts[i].quads);
+    }
+    memset(layouts, 0, sizeof(layouts));
+    layoutCount = 0;
+}
@@ -0,0 +1,38 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2025, BISMAYA JYOTI DALEI
+
+See the LICENSE file in the project root for the full license text.
+*/
+
+// Text layout cache.
+//
+// MeasureTextEx and DrawTextEx decode the string and look up every glyph
+// (a linear search through the font) on each call, and the menus and HUD call
+// them several times per frame on the same strings. This cache keys a layout
+// on (font, string, size, spacing) and keeps its extents and the positioned
+// glyph quads, so a cached string is measured and laid out once and drawing it
+// is just one textured quad per glyph. Output is identical to raylib's.
+//
+// Use it for strings that repeat (labels, prompts, score digits); strings that
+// change every frame or are drawn at a continuously animated size should keep
+// using raylib directly, or they just churn the cache.
+
+#ifndef PONG_TEXTCACHE_H
+#define PONG_TEXTCACHE_H
+
+#include "../include/raylib.h"
+
+#define TEXT_CACHE_SLOTS 256   // Power of two; the cache is flushed when 3/4 full
+
+// Same result as MeasureTextEx
+Vector2 TextCacheMeasure(Font font, const char *text, float fontSize, float spacing);
+
+// Same result as DrawTextEx
+void TextCacheDraw(Font font, const char *text, Vector2 position, float fontSize, float spacing, Color tint);
+
+// Drop every cached layout (and free its memory)
+void TextCacheClear(void);
+
+#endif // PONG_TEXTCACHE_H
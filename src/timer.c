@@ -0,0 +1,42 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2025, BISMAYA JYOTI DALEI
+
+See the LICENSE file in the project root for the full license text.
+*/
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 199309L
+#endif
+
+#include "timer.h"
+
+#if defined(_WIN32)
+// windows.h clashes with raylib names, which is why this lives in its own file
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+
+uint64_t TimerNowNs(void) {
+    static LARGE_INTEGER frequency = { 0 };
+    if (frequency.QuadPart == 0) QueryPerformanceFrequency(&frequency);
+
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+    uint64_t seconds = (uint64_t)(counter.QuadPart / frequency.QuadPart);
+    uint64_t remainder = (uint64_t)(counter.QuadPart % frequency.QuadPart);
+    return seconds * 1000000000ull + remainder * 1000000000ull / (uint64_t)frequency.QuadPart;
+}
+#else
+#include <time.h>
+
+uint64_t TimerNowNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+#endif
+
+double TimerNowSeconds(void) {
+    return (double)TimerNowNs() * 1e-9;
+}
@@ -0,0 +1,23 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2025, BISMAYA JYOTI DALEI
+
+See the LICENSE file in the project root for the full license text.
+*/
+
+// High-resolution monotonic clock. Kept out of raylib's way so it can be used
+// from the headless tools as well as the game.
+
+#ifndef PONG_TIMER_H
+#define PONG_TIMER_H
+
+#include <stdint.h>
+
+// Nanoseconds since an arbitrary fixed point
+uint64_t TimerNowNs(void);
+
+// Seconds since an arbitrary fixed point
+double TimerNowSeconds(void);
+
+#endif // PONG_TIMER_H
@@ -0,0 +1,213 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2025, BISMAYA JYOTI DALEI
+
+See the LICENSE file in the project root for the full license text.
+*/
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 199309L
+#endif
+
+#include "trace.h"
+#include "timer.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define TRACE_FLUSH_INTERVAL_NS 20000000L   // How often the flush thread drains the rings
+
+typedef struct {
+    const char *name;
+    uint64_t start;
+    uint64_t duration;
+} TraceEvent;
+
+// One per traced thread. Only the owner advances head and only the flush
+// thread advances tail, so neither side needs a lock.
+typedef struct TraceRing {
+    TraceEvent events[TRACE_RING_EVENTS];
+    atomic_uint head;
+    atomic_uint tail;
+    _Atomic(const char *) name;
+    int tid;
+    struct TraceRing *next;
+} TraceRing;
+
+static struct {
+    _Atomic(TraceRing *) rings;    // Every ring ever registered, newest first
+    atomic_int nextTid;
+    atomic_bool capturing;         // Zones are being recorded
+    atomic_bool busy;              // Capture running or its file still being written
+    atomic_bool stopRequested;
+    atomic_uint dropped;
+    // Owned by whichever thread starts and stops captures
+    pthread_t thread;
+    bool threadStarted;
+    // Owned by the flush thread while it runs
+    FILE *file;
+    uint64_t startNs;
+    uint64_t endNs;
+    bool wroteEvent;
+} trace;
+
+static _Thread_local TraceRing *localRing;
+
+static TraceRing *LocalRing(void) {
+    if (localRing != NULL) return localRing;
+
+    TraceRing *ring = calloc(1, sizeof(TraceRing));
+    if (ring == NULL) return NULL;
+    ring->tid = atomic_fetch_add(&trace.nextTid, 1) + 1;
+
+    // Push onto the shared list; rings are only removed by TraceShutdown
+    TraceRing *head = atomic_load(&trace.rings);
+    do {
+        ring->next = head;
+    } while (!atomic_compare_exchange_weak(&trace.rings, &head, ring));
+
+    localRing = ring;
+    return ring;
+}
+
+uint64_t TraceZoneBegin(void) {
+    return atomic_load_explicit(&trace.capturing, memory_order_relaxed) ? TimerNowNs() : 0;
+}
+
+void TraceZoneEnd(const char *name, uint64_t start) {
+    if (start == 0) return;
+    uint64_t end = TimerNowNs();
+
+    TraceRing *ring = LocalRing();
+    if (ring == NULL) return;
+
+    unsigned head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    unsigned tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+    if (head - tail >= TRACE_RING_EVENTS) {
+        atomic_fetch_add_explicit(&trace.dropped, 1, memory_order_relaxed);
+        return;
+    }
+
+    TraceEvent *event = &ring->events[head & (TRACE_RING_EVENTS - 1)];
+    event->name = name;
+    event->start = start;
+    event->duration = end - start;
+    atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+}
+
+void TraceNameThread(const char *name) {
+    TraceRing *ring = LocalRing();
+    if (ring != NULL) atomic_store(&ring->name, name);
+}
+
+// Write out everything the rings hold. Events from before this capture (a
+// zone that ended after the previous one stopped) are skipped.
+static void Drain(void) {
+    for (TraceRing *ring = atomic_load(&trace.rings); ring != NULL; ring = ring->next) {
+        unsigned head = atomic_load_explicit(&ring->head, memory_order_acquire);
+        unsigned tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+
+        for (; tail != head; tail++) {
+            const TraceEvent *event = &ring->events[tail & (TRACE_RING_EVENTS - 1)];
+            if (event->start < trace.startNs) continue;
+
+            fprintf(trace.file, "%s{\"name\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%d}",
+                    trace.wroteEvent ? ",\n" : "", event->name,
+                    (double)(event->start - trace.startNs) / 1e3, (double)event->duration / 1e3, ring->tid);
+            trace.wroteEvent = true;
+        }
+        atomic_store_explicit(&ring->tail, tail, memory_order_release);
+    }
+}
+
+static void SleepNs(long nanoseconds) {
+    struct timespec ts = { 0, nanoseconds };
+    nanosleep(&ts, NULL);
+}
+
+static void *TraceFlushMain(void *arg) {
+    (void)arg;
+
+    for (;;) {
+        bool stopping = atomic_load(&trace.stopRequested) || TimerNowNs() >= trace.endNs;
+        if (stopping) {
+            atomic_store(&trace.capturing, false);
+            // Let zones that were already open when capture ended finish
+            SleepNs(1000000L);
+        }
+        Drain();
+        if (stopping) break;
+        SleepNs(TRACE_FLUSH_INTERVAL_NS);
+    }
+
+    // Thread names as metadata events
+    for (TraceRing *ring = atomic_load(&trace.rings); ring != NULL; ring = ring->next) {
+        const char *name = atomic_load(&ring->name);
+        if (name == NULL) continue;
+        fprintf(trace.file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+                trace.wroteEvent ? ",\n" : "", ring->tid, name);
+        trace.wroteEvent = true;
+    }
+    fprintf(trace.file, "\n],\n\"displayTimeUnit\":\"ms\",\n\"otherData\":{\"droppedEvents\":%u}}\n",
+            atomic_load(&trace.dropped));
+    fclose(trace.file);
+    trace.file = NULL;
+
+    atomic_store(&trace.busy, false);
+    return NULL;
+}
+
+bool TraceStart(const char *path, double seconds) {
+    if (atomic_load(&trace.busy)) return false;
+    // Reap the thread of a capture that ended on its own
+    TraceStop();
+
+    trace.file = fopen(path, "w");
+    if (trace.file == NULL) return false;
+    fputs("{\"traceEvents\":[\n", trace.file);
+
+    trace.wroteEvent = false;
+    trace.startNs = TimerNowNs();
+    trace.endNs = (seconds > 0) ? trace.startNs + (uint64_t)(seconds * 1e9) : UINT64_MAX;
+    atomic_store(&trace.dropped, 0);
+    atomic_store(&trace.stopRequested, false);
+    atomic_store(&trace.busy, true);
+    atomic_store(&trace.capturing, true);
+
+    if (pthread_create(&trace.thread, NULL, TraceFlushMain, NULL) != 0) {
+        atomic_store(&trace.capturing, false);
+        atomic_store(&trace.busy, false);
+        fclose(trace.file);
+        trace.file = NULL;
+        return false;
+    }
+    trace.threadStarted = true;
+    return true;
+}
+
+void TraceStop(void) {
+    if (!trace.threadStarted) return;
+
+    atomic_store(&trace.stopRequested, true);
+    pthread_join(trace.thread, NULL);
+    trace.threadStarted = false;
+}
+
+bool TraceCapturing(void) {
+    return atomic_load(&trace.busy);
+}
+
+void TraceShutdown(void) {
+    TraceStop();
+
+    TraceRing *ring = atomic_exchange(&trace.rings, NULL);
+    while (ring != NULL) {
+        TraceRing *next = ring->next;
+        free(ring);
+        ring = next;
+    }
+    localRing = NULL;
+}
@@ -0,0 +1,64 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2025, BISMAYA JYOTI DALEI
+
+See the LICENSE file in the project root for the full license text.
+*/
+
+// Zone tracing to Chrome trace-event JSON (chrome://tracing, ui.perfetto.dev).
+//
+// Code brackets a zone with TraceZoneBegin/TraceZoneEnd. While no capture is
+// running TraceZoneBegin is one relaxed atomic load and TraceZoneEnd returns
+// at once, so the zones stay compiled into release builds. During a capture
+// each thread appends finished zones to its own single-producer ring (no
+// locks, no allocation after the thread's first event) and a background
+// thread drains every ring to the file, so the traced threads never touch
+// the disk. A full ring drops events rather than blocking; the count of
+// dropped events is written into the trace.
+//
+// No raylib in here, but the sim is also built into headless tools that
+// shouldn't need this file or pthreads, so sim.c uses TRACE_ZONE_BEGIN and
+// TRACE_ZONE_END instead: they compile to nothing unless PONG_TRACE is defined.
+
+#ifndef PONG_TRACE_H
+#define PONG_TRACE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define TRACE_RING_EVENTS 16384   // Per thread; a power of two
+
+// Start capturing to path for the next seconds (<= 0 runs until TraceStop).
+// Returns false if a capture is already running or the file can't be created.
+bool TraceStart(const char *path, double seconds);
+
+// End the capture early and finish the file. Safe to call when idle.
+void TraceStop(void);
+
+// True from TraceStart until the capture has ended
+bool TraceCapturing(void);
+
+// Start of a zone; 0 when not capturing
+uint64_t TraceZoneBegin(void);
+
+// Record a zone that began at start. name must be a string literal (only the
+// pointer is stored until the file is written).
+void TraceZoneEnd(const char *name, uint64_t start);
+
+#ifdef PONG_TRACE
+#define TRACE_ZONE_BEGIN() TraceZoneBegin()
+#define TRACE_ZONE_END(name, start) TraceZoneEnd(name, start)
+#else
+#define TRACE_ZONE_BEGIN() ((uint64_t)0)
+#define TRACE_ZONE_END(name, start) ((void)(start))
+#endif
+
+// Label the calling thread in the trace (string literal)
+void TraceNameThread(const char *name);
+
+// Stop any capture and free every thread's ring. Call once no other thread
+// will record zones again.
+void TraceShutdown(void);
+
+#endif // PONG_TRACE_H
@@ -0,0 +1,146 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2025, BISMAYA JYOTI DALEI
+
+See the LICENSE file in the project root for the full license text.
+*/
+
+// Checks for the per-frame / per-tick input split in src/input.c. Each case
+// pushes events with chosen timestamps, runs frames and ticks at chosen times
+// the way main.c's fixed-step loop does, and checks what the tick view sees.
+// Prints one line per case and exits with status 1 if any failed.
+//
+//   inputtest
+
+#include "../src/input.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#define MS 1000000ULL
+#define TICK_NS (1000000000ULL / 60)
+#define KEY_W 87
+#define AXIS_LEFT_Y 1
+
+static InputSystem input;
+static int failures;
+
+static void Start(void) {
+    memset(&input, 0, sizeof(input));
+}
+
+static void Push(uint64_t timeNs, InputEventType type, int code, float value) {
+    InputEvent event = { .timeNs = timeNs, .type = (uint8_t)type, .code = (uint16_t)code, .value = value };
+    InputQueuePush(&input.queue, &event);
+}
+
+static void Check(const char *name, bool passed) {
+    printf("%-52s %s\n", name, passed ? "ok" : "FAILED");
+    if (!passed) failures++;
+}
+
+// Press at 5 ms and release at 7 ms, inside a frame too short to run a tick;
+// the tick covering them runs in the next frame
+static void TapInTicklessFrame(void) {
+    Start();
+    Push(5 * MS, INPUT_EVENT_KEY, KEY_W, 1.0f);
+    Push(7 * MS, INPUT_EVENT_KEY, KEY_W, 0.0f);
+    InputBeginFrame(&input, 8 * MS);
+    bool framePressed = InputKeyPressed(&input.frame, KEY_W);
+
+    InputBeginFrame(&input, 17 * MS);
+    InputBeginTick(&input, TICK_NS, TICK_NS);
+    Check("tap in a tickless frame reaches the next tick",
+          framePressed && InputKeyActive(&input.tick, KEY_W) && !InputKeyDown(&input.tick, KEY_W));
+}
+
+// Pressed in a tickless frame, released in the next one before its tick
+static void TapAcrossFrames(void) {
+    Start();
+    Push(5 * MS, INPUT_EVENT_KEY, KEY_W, 1.0f);
+    InputBeginFrame(&input, 8 * MS);
+    Push(12 * MS, INPUT_EVENT_KEY, KEY_W, 0.0f);
+    InputBeginFrame(&input, 17 * MS);
+    InputBeginTick(&input, TICK_NS, TICK_NS);
+    Check("tap across a tickless frame reaches the next tick", InputKeyActive(&input.tick, KEY_W));
+}
+
+// A press after the end of the frame's last tick belongs to the tick after
+static void PressPastLastTick(void) {
+    Start();
+    Push(20 * MS, INPUT_EVENT_KEY, KEY_W, 1.0f);
+    InputBeginFrame(&input, 21 * MS);
+    InputBeginTick(&input, TICK_NS, TICK_NS);
+    bool early = InputKeyActive(&input.tick, KEY_W);
+
+    InputBeginFrame(&input, 30 * MS);
+    InputBeginTick(&input, 2 * TICK_NS, TICK_NS);
+    Check("press past a tick waits for the tick covering it",
+          !early && InputKeyPressed(&input.tick, KEY_W) && input.pendingCount == 0);
+}
+
+// With no ticks running (menus, pause) the tick view still follows the keys
+static void FlushWithoutTicks(void) {
+    Start();
+    Push(1 * MS, INPUT_EVENT_KEY, KEY_W, 1.0f);
+    InputBeginFrame(&input, 2 * MS);
+    InputFlushTicks(&input);
+    bool held = InputKeyDown(&input.tick, KEY_W);
+
+    Push(3 * MS, INPUT_EVENT_KEY, KEY_W, 0.0f);
+    InputBeginFrame(&input, 4 * MS);
+    InputFlushTicks(&input);
+    Check("flush without ticks keeps the tick view current",
+          held && !InputKeyDown(&input.tick, KEY_W) && input.pendingCount == 0);
+}
+
+// Stick pushed a quarter of the way into a tick, seen first by a tickless
+// frame: the tick's average still weights it by the time it was held
+static void AxisInTicklessFrame(void) {
+    Start();
+    Push(TICK_NS / 4, INPUT_EVENT_GAMEPAD_AXIS, AXIS_LEFT_Y, 1.0f);
+    InputBeginFrame(&input, 8 * MS);
+    InputBeginFrame(&input, 17 * MS);
+    InputBeginTick(&input, TICK_NS, TICK_NS);
+    float mean = InputGamepadAxisMean(&input.tick, 0, AXIS_LEFT_Y);
+    Check("axis change in a tickless frame is time-weighted", fabsf(mean - 0.75f) < 1e-4f);
+}
+
+// A stick sample taken right before a tick, after the frame drained the
+// queue: the tick covering it gets it, the frame view only from the next frame
+static void CollectBeforeTick(void) {
+    Start();
+    InputBeginFrame(&input, 10 * MS);
+    Push(11 * MS, INPUT_EVENT_GAMEPAD_AXIS, AXIS_LEFT_Y, 1.0f);
+    InputCollect(&input, 12 * MS);
+    bool frameEarly = InputGamepadAxis(&input.frame, 0, AXIS_LEFT_Y) != 0.0f;
+    InputBeginTick(&input, TICK_NS, TICK_NS);
+    float mean = InputGamepadAxisMean(&input.tick, 0, AXIS_LEFT_Y);
+
+    InputBeginFrame(&input, 20 * MS);
+    Check("sample collected before a tick reaches that tick",
+          !frameEarly && fabsf(mean - (float)(TICK_NS - 11 * MS) / TICK_NS) < 1e-4f &&
+          InputGamepadAxis(&input.frame, 0, AXIS_LEFT_Y) == 1.0f);
+}
+
+int main(int argc, char **argv) {
+    (void)argv;
+    if (argc > 1) {
+        fprintf(stderr, "usage: inputtest\n");
+        return 1;
+    }
+
+    TapInTicklessFrame();
+    TapAcrossFrames();
+    PressPastLastTick();
+    FlushWithoutTicks();
+    AxisInTicklessFrame();
+    CollectBeforeTick();
+
+    if (failures > 0) {
+        printf("%d case%s failed\n", failures, failures == 1 ? "" : "s");
+        return 1;
+    }
+    return 0;
+}
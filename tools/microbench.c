@@ -0,0 +1,388 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2025, BISMAYA JYOTI DALEI
+
+See the LICENSE file in the project root for the full license text.
+*/
+
+// Microbenchmarks for the game's hot paths: the swept paddle collision, the
+// AI, intercept prediction, serving, a full sim tick, particle spawn and
+// update, and the background gradient fill.
+//
+// Sim benchmarks run over a pool of states snapshotted from seeded AI-vs-AI
+// matches, so they see the positions and velocities real play produces, and
+// every run sees the same ones. Each benchmark runs a warm-up batch and then
+// --reps timed batches. The ns/op it reports and compares is the fastest
+// batch: interference from the rest of the machine only ever adds time, so
+// the minimum is far steadier from run to run than the median. The median
+// and the spread across batches are printed next to it.
+//
+//   microbench [--reps N] [--filter TEXT] [--out FILE] [--baseline FILE] [--threshold PCT]
+//
+// --out writes the results as JSON, which is also the baseline format.
+// --baseline compares each ns/op against a stored run and exits with status
+// 1 if any benchmark got more than --threshold percent (default 15) slower.
+
+#include "../src/gradient.h"
+#include "../src/particles.h"
+#include "../src/rng.h"
+#include "../src/sim.h"
+#include "../src/timer.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_REPS 101
+#define POOL_SIZE 1024            // Sim states sampled from real matches
+#define GRADIENT_ROWS 800         // One texel per row at the default window height
+#define PARTICLE_CAPACITY 16384   // MAX_PARTICLES in main.c
+#define PARTICLE_LIVE 2000        // Live particles during busy rallies
+
+typedef struct {
+    const char *name;
+    const char *unit;           // What one op is
+    void (*setup)(void);        // Untimed, before every batch
+    uint64_t (*run)(void);      // One timed batch; returns ops performed
+} Benchmark;
+
+typedef struct {
+    double median;
+    double mean;
+    double stddev;
+    double min;
+} BenchResult;
+
+static volatile float sink;      // Keeps results alive past the optimizer
+
+static SimState pristinePool[POOL_SIZE];
+static SimState pool[POOL_SIZE];
+static ParticleSystem particles;
+static Rng particleRng;
+static unsigned char gradientPixels[GRADIENT_ROWS * 4];
+
+// Snapshot states from seeded AI-vs-AI matches at random ticks
+static void BuildPool(void) {
+    Rng rng;
+    RngSeed(&rng, 2025, RNG_STREAM_COSMETIC);
+
+    SimState sim;
+    SimInput input = { .aiControlled = { true, true } };
+    SimEvent events[SIM_MAX_EVENTS];
+    uint64_t match = 1;
+    SimInit(&sim, 1.0f, SIM_DEFAULT_WIN_SCORE, match);
+
+    for (int i = 0; i < POOL_SIZE; i++) {
+        int skip = RngRange(&rng, 1, 240);
+        for (int t = 0; t < skip; t++) {
+            if (sim.matchOver) SimInit(&sim, 0.5f + (float)RngRange(&rng, 0, 15) / 10.0f, SIM_DEFAULT_WIN_SCORE, ++match);
+            SimStep(&sim, &input, events);
+        }
+        pristinePool[i] = sim;
+    }
+}
+
+static void ResetPool(void) {
+    memcpy(pool, pristinePool, sizeof(pool));
+}
+
+//----------------------------------------------------------------------------------
+// Benchmarks
+//----------------------------------------------------------------------------------
+
+static uint64_t RunSweepPaddle(void) {
+    float total = 0.0f;
+    for (int pass = 0; pass < 256; pass++) {
+        for (int i = 0; i < POOL_SIZE; i++) {
+            const SimState *sim = &pool[i];
+            SimVec2 move = sim->ball.velocity;
+            total += SimSweepPaddle(&sim->ball, move, &sim->paddles[SIM_SIDE_LEFT]);
+            total += SimSweepPaddle(&sim->ball, move, &sim->paddles[SIM_SIDE_RIGHT]);
+        }
+    }
+    sink = total;
+    return 256ull * POOL_SIZE * 2;
+}
+
+static uint64_t RunPredictIntercept(void) {
+    float total = 0.0f;
+    for (int pass = 0; pass < 256; pass++) {
+        for (int i = 0; i < POOL_SIZE; i++) {
+            const SimBall *ball = &pool[i].ball;
+            float contactX = (ball->velocity.x > 0.0f) ? pool[i].paddles[SIM_SIDE_RIGHT].rect.x - ball->radius
+                                                       : pool[i].paddles[SIM_SIDE_LEFT].rect.x +
+                                                         pool[i].paddles[SIM_SIDE_LEFT].rect.width + ball->radius;
+            float y = 0.0f;
+            if (SimPredictIntercept(ball, contactX, &y)) total += y;
+        }
+    }
+    sink = total;
+    return 256ull * POOL_SIZE;
+}
+
+// The ball doesn't move between calls, so after the first pass this is the
+// cached per-tick path the game runs between bounces
+static uint64_t RunUpdateAI(void) {
+    for (int pass = 0; pass < 128; pass++) {
+        for (int i = 0; i < POOL_SIZE; i++) {
+            SimUpdateAI(&pool[i], SIM_SIDE_LEFT);
+            SimUpdateAI(&pool[i], SIM_SIDE_RIGHT);
+        }
+    }
+    sink = pool[0].paddles[SIM_SIDE_RIGHT].rect.y;
+    return 128ull * POOL_SIZE * 2;
+}
+
+static uint64_t RunResetBall(void) {
+    for (int pass = 0; pass < 256; pass++) {
+        for (int i = 0; i < POOL_SIZE; i++) {
+            SimResetBall(&pool[i], (SimSide)((i + pass) & 1));
+        }
+    }
+    sink = pool[0].ball.velocity.y;
+    return 256ull * POOL_SIZE;
+}
+
+static uint64_t RunSimStep(void) {
+    SimInput input = { .aiControlled = { true, true } };
+    SimEvent events[SIM_MAX_EVENTS];
+    int total = 0;
+    for (int pass = 0; pass < 32; pass++) {
+        for (int i = 0; i < POOL_SIZE; i++) {
+            // Finished matches do nothing; serve again so every op is a real tick
+            if (pool[i].matchOver) {
+                pool[i].matchOver = false;
+                pool[i].scores[0] = pool[i].scores[1] = 0;
+            }
+            total += SimStep(&pool[i], &input, events);
+        }
+    }
+    sink = (float)total;
+    return 32ull * POOL_SIZE;
+}
+
+// The spawning half of CreateParticleEffect: bursts of 15 with the game's parameters
+static void SetupParticleSpawn(void) {
+    ParticleClear(&particles);
+    RngSeed(&particleRng, 7, RNG_STREAM_COSMETIC);
+}
+
+static uint64_t RunParticleSpawn(void) {
+    uint64_t spawned = 0;
+    for (int burst = 0; burst < 1024; burst++) {
+        if (particles.count + 15 > particles.capacity) ParticleClear(&particles);
+
+        float x = (float)RngRange(&particleRng, 0, SIM_COURT_WIDTH);
+        float y = (float)RngRange(&particleRng, 0, SIM_COURT_HEIGHT);
+        for (int i = 0; i < 15; i++) {
+            float vx = (float)RngRange(&particleRng, -200, 200) / 100.0f * 60.0f;
+            float vy = (float)RngRange(&particleRng, -200, 200) / 100.0f * 60.0f;
+            float lifetime = (float)RngRange(&particleRng, 30, 90) / 100.0f;
+            float size = (float)RngRange(&particleRng, 2, 6);
+            spawned += ParticleSpawn(&particles, x, y, vx, vy, lifetime, size, 0xCCFFFFFFu);
+        }
+    }
+    return spawned;
+}
+
+// UpdateParticles at a busy rally's particle count
+static void SetupParticleUpdate(void) {
+    SetupParticleSpawn();
+    while (particles.count < PARTICLE_LIVE) RunParticleSpawn();
+    particles.count = PARTICLE_LIVE;
+}
+
+static uint64_t RunParticleUpdate(void) {
+    uint64_t updated = 0;
+    // Steps short enough that none reach their 0.3 s minimum lifetime within
+    // the batch, so every batch updates the same count
+    for (int frame = 0; frame < 128; frame++) {
+        updated += (uint64_t)particles.count;
+        ParticleUpdate(&particles, 1.0f / 480.0f);
+    }
+    return updated;
+}
+
+static uint64_t RunGradient(void) {
+    const unsigned char top[4] = { 12, 20, 28, 255 };
+    const unsigned char bottom[4] = { 24, 24, 36, 255 };
+    for (int fill = 0; fill < 256; fill++) {
+        GradientFillRows(top, bottom, gradientPixels, GRADIENT_ROWS);
+    }
+    sink = gradientPixels[GRADIENT_ROWS * 2];
+    return 256;
+}
+
+static const Benchmark benchmarks[] = {
+    { "SimSweepPaddle",      "sweep",    ResetPool,           RunSweepPaddle },
+    { "SimPredictIntercept", "predict",  ResetPool,           RunPredictIntercept },
+    { "SimUpdateAI",         "AI tick",  ResetPool,           RunUpdateAI },
+    { "SimResetBall",        "serve",    ResetPool,           RunResetBall },
+    { "SimStep",             "tick",     ResetPool,           RunSimStep },
+    { "ParticleSpawn",       "particle", SetupParticleSpawn,  RunParticleSpawn },
+    { "ParticleUpdate",      "particle", SetupParticleUpdate, RunParticleUpdate },
+    { "GradientFillRows",    "800 rows", NULL,                RunGradient },
+};
+#define BENCHMARK_COUNT (int)(sizeof(benchmarks) / sizeof(benchmarks[0]))
+
+//----------------------------------------------------------------------------------
+// Harness
+//----------------------------------------------------------------------------------
+
+static int CompareDoubles(const void *a, const void *b) {
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static BenchResult Measure(const Benchmark *bench, int reps) {
+    double samples[MAX_REPS];
+
+    // Warm caches and branch predictors before anything is timed
+    if (bench->setup) bench->setup();
+    bench->run();
+
+    for (int r = 0; r < reps; r++) {
+        if (bench->setup) bench->setup();
+        uint64_t t0 = TimerNowNs();
+        uint64_t ops = bench->run();
+        uint64_t t1 = TimerNowNs();
+        samples[r] = (double)(t1 - t0) / (double)(ops > 0 ? ops : 1);
+    }
+
+    BenchResult result = { 0 };
+    for (int r = 0; r < reps; r++) result.mean += samples[r];
+    result.mean /= reps;
+    for (int r = 0; r < reps; r++) result.stddev += (samples[r] - result.mean) * (samples[r] - result.mean);
+    result.stddev = sqrt(result.stddev / reps);
+
+    qsort(samples, (size_t)reps, sizeof(double), CompareDoubles);
+    result.median = samples[reps / 2];
+    result.min = samples[0];
+    return result;
+}
+
+// ns/op stored for name in a file written by --out, or -1
+static double BaselineFor(const char *json, const char *name) {
+    char key[96];
+    snprintf(key, sizeof(key), "\"name\": \"%s\"", name);
+    const char *entry = strstr(json, key);
+    if (entry == NULL) return -1.0;
+    const char *field = strstr(entry, "\"nsPerOp\":");
+    if (field == NULL) return -1.0;
+    return strtod(field + strlen("\"nsPerOp\":"), NULL);
+}
+
+static char *ReadFile(const char *path) {
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) return NULL;
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    char *text = (size >= 0) ? malloc((size_t)size + 1) : NULL;
+    if (text != NULL) {
+        size_t got = fread(text, 1, (size_t)size, file);
+        text[got] = '\0';
+    }
+    fclose(file);
+    return text;
+}
+
+static void PrintUsage(const char *program) {
+    fprintf(stderr, "usage: %s [--reps N] [--filter TEXT] [--out FILE] [--baseline FILE] [--threshold PCT]\n",
+            program);
+}
+
+int main(int argc, char **argv) {
+    int reps = 15;
+    const char *filter = NULL;
+    const char *outPath = NULL;
+    const char *baselinePath = NULL;
+    double threshold = 15.0;
+
+    for (int i = 1; i < argc; i++) {
+        const char *value = (i + 1 < argc) ? argv[i + 1] : NULL;
+        if (value == NULL) { PrintUsage(argv[0]); return 1; }
+
+        if (strcmp(argv[i], "--reps") == 0) reps = atoi(value);
+        else if (strcmp(argv[i], "--filter") == 0) filter = value;
+        else if (strcmp(argv[i], "--out") == 0) outPath = value;
+        else if (strcmp(argv[i], "--baseline") == 0) baselinePath = value;
+        else if (strcmp(argv[i], "--threshold") == 0) threshold = atof(value);
+        else { PrintUsage(argv[0]); return 1; }
+        i++;
+    }
+    if (reps <= 0 || reps > MAX_REPS || threshold <= 0.0) {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+
+    char *baseline = NULL;
+    if (baselinePath != NULL && (baseline = ReadFile(baselinePath)) == NULL) {
+        fprintf(stderr, "could not read %s\n", baselinePath);
+        return 1;
+    }
+    if (!ParticleSystemInit(&particles, PARTICLE_CAPACITY)) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+    BuildPool();
+
+    BenchResult results[BENCHMARK_COUNT];
+    bool ran[BENCHMARK_COUNT] = { false };
+    int regressions = 0;
+
+    printf("%-20s %10s %10s %8s   %s\n", "benchmark", "ns/op", "median", "+-%", "baseline");
+    for (int b = 0; b < BENCHMARK_COUNT; b++) {
+        const Benchmark *bench = &benchmarks[b];
+        if (filter != NULL && strstr(bench->name, filter) == NULL) continue;
+
+        results[b] = Measure(bench, reps);
+        ran[b] = true;
+
+        const BenchResult *r = &results[b];
+        printf("%-20s %10.2f %10.2f %7.1f%%   ", bench->name, r->min, r->median,
+               r->mean > 0.0 ? 100.0 * r->stddev / r->mean : 0.0);
+
+        double expected = (baseline != NULL) ? BaselineFor(baseline, bench->name) : -1.0;
+        if (expected <= 0.0) {
+            printf("%s\n", baseline != NULL ? "new" : "-");
+        } else {
+            double change = 100.0 * (r->min - expected) / expected;
+            bool regressed = change > threshold;
+            printf("%.2f (%+.1f%%)%s\n", expected, change, regressed ? "  REGRESSION" : "");
+            if (regressed) regressions++;
+        }
+    }
+
+    if (outPath != NULL) {
+        FILE *out = fopen(outPath, "w");
+        if (out == NULL) {
+            fprintf(stderr, "could not write %s\n", outPath);
+            return 1;
+        }
+        fprintf(out, "{\n  \"kernel\": \"%s\",\n  \"reps\": %d,\n  \"benchmarks\": [\n", ParticleKernelName(), reps);
+        bool first = true;
+        for (int b = 0; b < BENCHMARK_COUNT; b++) {
+            if (!ran[b]) continue;
+            fprintf(out, "%s    { \"name\": \"%s\", \"unit\": \"%s\", \"nsPerOp\": %.3f, \"median\": %.3f, "
+                    "\"mean\": %.3f, \"stddev\": %.3f }",
+                    first ? "" : ",\n", benchmarks[b].name, benchmarks[b].unit,
+                    results[b].min, results[b].median, results[b].mean, results[b].stddev);
+            first = false;
+        }
+        fprintf(out, "\n  ]\n}\n");
+        fclose(out);
+    }
+
+    free(baseline);
+    ParticleSystemFree(&particles);
+    if (regressions > 0) {
+        printf("%d benchmark%s more than %.0f%% slower than the baseline\n",
+               regressions, regressions == 1 ? "" : "s", threshold);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,119 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2025, BISMAYA JYOTI DALEI
+
+See the LICENSE file in the project root for the full license text.
+*/
+
+// Particle engine benchmark. Keeps a system topped up at N live particles
+// with the same lifetimes, speeds and sizes the game spawns, runs it for a
+// number of 60 Hz frames and reports update throughput in particles per
+// millisecond for the scalar reference and the SIMD kernel, plus the cost of
+// the respawn (spawn + kill) traffic.
+//
+//   particlebench [--particles N] [--frames F]
+//
+// Without --particles it runs 10k and 100k.
+
+#include "../src/particles.h"
+#include "../src/rng.h"
+#include "../src/timer.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef void (*UpdateFn)(ParticleSystem *ps, float dt);
+
+typedef struct {
+    double updateMs;
+    double spawnMs;
+    uint64_t updated;    // Particle updates performed
+    uint64_t spawned;
+} BenchResult;
+
+static void TopUp(ParticleSystem *ps, int target, Rng *rng, uint64_t *spawned) {
+    while (ps->count < target) {
+        ParticleSpawn(ps,
+                      (float)RngRange(rng, 0, 1280), (float)RngRange(rng, 0, 800),
+                      (float)RngRange(rng, -200, 200) / 100.0f * 60.0f,
+                      (float)RngRange(rng, -200, 200) / 100.0f * 60.0f,
+                      (float)RngRange(rng, 30, 90) / 100.0f,
+                      (float)RngRange(rng, 2, 6),
+                      0xCCFFFFFFu);
+        (*spawned)++;
+    }
+}
+
+static BenchResult Run(UpdateFn update, int particles, int frames) {
+    BenchResult result = { 0 };
+    ParticleSystem ps;
+    if (!ParticleSystemInit(&ps, particles)) {
+        fprintf(stderr, "out of memory\n");
+        exit(1);
+    }
+
+    Rng rng;
+    RngSeed(&rng, 1, RNG_STREAM_COSMETIC);
+    uint64_t spawned = 0;
+    TopUp(&ps, particles, &rng, &spawned);
+
+    const float dt = 1.0f / 60.0f;
+    for (int frame = 0; frame < frames; frame++) {
+        uint64_t t0 = TimerNowNs();
+        result.updated += (uint64_t)ps.count;
+        update(&ps, dt);
+        uint64_t t1 = TimerNowNs();
+        TopUp(&ps, particles, &rng, &result.spawned);
+        uint64_t t2 = TimerNowNs();
+
+        result.updateMs += (double)(t1 - t0) / 1e6;
+        result.spawnMs += (double)(t2 - t1) / 1e6;
+    }
+
+    ParticleSystemFree(&ps);
+    return result;
+}
+
+static void Report(int particles, int frames) {
+    BenchResult scalar = Run(ParticleUpdateScalar, particles, frames);
+    BenchResult simd = Run(ParticleUpdate, particles, frames);
+
+    double scalarRate = scalar.updated / scalar.updateMs;
+    double simdRate = simd.updated / simd.updateMs;
+    printf("%9d particles  %-6s %10.0f /ms   scalar %10.0f /ms   %5.2fx   "
+           "update %.3f ms/frame   spawn+kill %.0f /ms\n",
+           particles, ParticleKernelName(), simdRate, scalarRate, simdRate / scalarRate,
+           simd.updateMs / frames, simd.spawned / (simd.spawnMs > 0.0 ? simd.spawnMs : 1e-9));
+}
+
+static void PrintUsage(const char *program) {
+    fprintf(stderr, "usage: %s [--particles N] [--frames F]\n", program);
+}
+
+int main(int argc, char **argv) {
+    int particles = 0;
+    int frames = 600;
+
+    for (int i = 1; i < argc; i++) {
+        const char *value = (i + 1 < argc) ? argv[i + 1] : NULL;
+        if (value == NULL) { PrintUsage(argv[0]); return 1; }
+
+        if (strcmp(argv[i], "--particles") == 0) particles = atoi(value);
+        else if (strcmp(argv[i], "--frames") == 0) frames = atoi(value);
+        else { PrintUsage(argv[0]); return 1; }
+        i++;
+    }
+    if (frames <= 0 || particles < 0) {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+
+    if (particles > 0) {
+        Report(particles, frames);
+    } else {
+        Report(10000, frames);
+        Report(100000, frames);
+    }
+    return 0;
+}
@@ -0,0 +1,491 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2025, BISMAYA JYOTI DALEI
+
+See the LICENSE file in the project root for the full license text.
+*/
+
+// Headless batch runner: plays many complete AI-vs-AI matches across all
+// cores and reports throughput, score distributions and rally lengths.
+//
+//   pongbatch [--matches N] [--threads T] [--speed M] [--win W]
+//             [--seed S] [--max-frames F] [--left AI] [--right AI]
+//             [--soa | --calibrate]
+//
+// --left/--right pick each side's AI: a tier name (easy, normal, hard,
+// expert) or "reference", the player model tiers are calibrated against.
+//
+// --soa skips the threaded run and instead times one thread stepping the
+// same number of matches through SimStep, the scalar SoA kernel and the
+// SIMD SoA kernel.
+//
+// --calibrate tunes every tier: it bisects the skill level of an AI playing
+// against the reference model until the AI wins the tier's target share of
+// points, then prints the tier table for src/sim.c. Points rather than
+// matches: a first-to-10 match turns a small edge per point into a lopsided
+// match result, so match wins would squeeze every tier into a narrow band.
+
+#include "../src/sim.h"
+#include "../src/sim_soa.h"
+#include "../src/timer.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+#define MAX_WORKERS 256
+#define MAX_WIN_SCORE 64
+#define RALLY_BUCKETS 32        // Last bucket collects everything longer
+#define DEFAULT_MAX_FRAMES (60 * 60 * 30)   // 30 minutes of game time
+#define CALIBRATION_STEPS 12    // Bisection steps per tier (skill resolution 1/4096)
+
+// Share of points each tier should win against the reference player model
+static const float tierTargetWinRate[SIM_AI_TIER_COUNT] = {
+    [SIM_AI_EASY] = 0.30f,
+    [SIM_AI_NORMAL] = 0.50f,
+    [SIM_AI_HARD] = 0.70f,
+    [SIM_AI_EXPERT] = 0.85f,
+};
+
+typedef struct {
+    int matches;
+    int threads;
+    float speed;
+    int winScore;
+    uint32_t seed;
+    uint32_t maxFrames;
+    SimAiProfile ai[2];
+    bool compareSoA;
+    bool calibrate;
+} BatchConfig;
+
+typedef struct {
+    uint64_t matches;
+    uint64_t unfinished;        // Hit maxFrames before anyone reached winScore
+    uint64_t frames;
+    uint64_t points;
+    uint64_t pointsWon[2];
+    uint64_t wins[2];
+    uint64_t loserScore[2][MAX_WIN_SCORE];   // [winner][loser's final score]
+    uint64_t rallyHistogram[RALLY_BUCKETS];  // Paddle hits per point
+} BatchStats;
+
+// Each worker owns a range of match indices packed as (tail << 32 | head).
+// The owner pops from the head, thieves take the upper half from the tail,
+// and both sides go through a CAS on the same word so a match is never run
+// twice or skipped.
+typedef struct BatchWorker {
+    _Alignas(64) _Atomic uint64_t range;
+    BatchStats stats;
+    const BatchConfig *config;
+    int index;
+    int workerCount;
+    struct BatchWorker *all;
+} BatchWorker;
+
+static uint64_t PackRange(uint32_t head, uint32_t tail) {
+    return ((uint64_t)tail << 32) | head;
+}
+
+static bool PopLocal(BatchWorker *worker, uint32_t *match) {
+    uint64_t range = atomic_load(&worker->range);
+    for (;;) {
+        uint32_t head = (uint32_t)range;
+        uint32_t tail = (uint32_t)(range >> 32);
+        if (head >= tail) return false;
+        if (atomic_compare_exchange_weak(&worker->range, &range, PackRange(head + 1, tail))) {
+            *match = head;
+            return true;
+        }
+    }
+}
+
+static bool StealFrom(BatchWorker *victim, BatchWorker *thief) {
+    uint64_t range = atomic_load(&victim->range);
+    for (;;) {
+        uint32_t head = (uint32_t)range;
+        uint32_t tail = (uint32_t)(range >> 32);
+        if (head >= tail) return false;
+
+        uint32_t take = (tail - head + 1) / 2;
+        if (atomic_compare_exchange_weak(&victim->range, &range, PackRange(head, tail - take))) {
+            // Our own range is empty, so nobody else can be touching it
+            atomic_store(&thief->range, PackRange(tail - take, tail));
+            return true;
+        }
+    }
+}
+
+// RngSeed scrambles its input, so a plain (base, index) pack is enough
+static uint64_t MatchSeed(uint32_t baseSeed, uint32_t match) {
+    return ((uint64_t)baseSeed << 32) | match;
+}
+
+static void PlayMatch(const BatchConfig *config, uint32_t match, BatchStats *stats) {
+    SimState sim;
+    SimInit(&sim, config->speed, config->winScore, MatchSeed(config->seed, match));
+    SimSetAi(&sim, SIM_SIDE_LEFT, &config->ai[SIM_SIDE_LEFT]);
+    SimSetAi(&sim, SIM_SIDE_RIGHT, &config->ai[SIM_SIDE_RIGHT]);
+
+    SimInput input = { 0 };
+    input.aiControlled[SIM_SIDE_LEFT] = true;
+    input.aiControlled[SIM_SIDE_RIGHT] = true;
+
+    SimEvent events[SIM_MAX_EVENTS];
+    int rally = 0;
+
+    while (!sim.matchOver && sim.frame < config->maxFrames) {
+        int eventCount = SimStep(&sim, &input, events);
+        for (int i = 0; i < eventCount; i++) {
+            if (events[i].type == SIM_EVENT_PADDLE_HIT) {
+                rally++;
+            } else if (events[i].type == SIM_EVENT_SCORE) {
+                stats->pointsWon[events[i].side]++;
+                stats->rallyHistogram[rally < RALLY_BUCKETS ? rally : RALLY_BUCKETS - 1]++;
+                stats->points++;
+                rally = 0;
+            }
+        }
+    }
+
+    stats->matches++;
+    stats->frames += sim.frame;
+
+    if (!sim.matchOver) {
+        stats->unfinished++;
+        return;
+    }
+
+    int winner = (sim.scores[SIM_SIDE_LEFT] >= sim.winScore) ? SIM_SIDE_LEFT : SIM_SIDE_RIGHT;
+    stats->wins[winner]++;
+    stats->loserScore[winner][sim.scores[1 - winner]]++;
+}
+
+static void *WorkerMain(void *arg) {
+    BatchWorker *self = (BatchWorker *)arg;
+    BatchWorker *workers = self->all;
+    uint32_t victimSeed = (uint32_t)self->index * 2654435761u + 1;
+
+    for (;;) {
+        uint32_t match;
+        while (PopLocal(self, &match)) {
+            PlayMatch(self->config, match, &self->stats);
+        }
+
+        // Out of local work: try every other worker once, starting at a random one
+        bool stole = false;
+        victimSeed ^= victimSeed << 13;
+        victimSeed ^= victimSeed >> 17;
+        victimSeed ^= victimSeed << 5;
+        for (int i = 0; i < self->workerCount && !stole; i++) {
+            BatchWorker *victim = &workers[(victimSeed + (uint32_t)i) % (uint32_t)self->workerCount];
+            if (victim != self) stole = StealFrom(victim, self);
+        }
+
+        // Work is never added after start, so a fruitless pass means we're done
+        if (!stole) break;
+    }
+
+    return NULL;
+}
+
+static int CpuCount(void) {
+#if defined(_WIN32)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (int)info.dwNumberOfProcessors;
+#else
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return (count > 0) ? (int)count : 1;
+#endif
+}
+
+static void MergeStats(BatchStats *into, const BatchStats *from) {
+    into->matches += from->matches;
+    into->unfinished += from->unfinished;
+    into->frames += from->frames;
+    into->points += from->points;
+    for (int side = 0; side < 2; side++) {
+        into->pointsWon[side] += from->pointsWon[side];
+        into->wins[side] += from->wins[side];
+        for (int s = 0; s < MAX_WIN_SCORE; s++) into->loserScore[side][s] += from->loserScore[side][s];
+    }
+    for (int i = 0; i < RALLY_BUCKETS; i++) into->rallyHistogram[i] += from->rallyHistogram[i];
+}
+
+static void PrintReport(const BatchConfig *config, const BatchStats *stats, double seconds) {
+    printf("matches      %llu (%llu hit the %u frame cap)\n",
+           (unsigned long long)stats->matches, (unsigned long long)stats->unfinished, config->maxFrames);
+    printf("threads      %d\n", config->threads);
+    printf("wall time    %.3f s\n", seconds);
+    printf("matches/sec  %.1f\n", stats->matches / seconds);
+    printf("frames/sec   %.0f\n", stats->frames / seconds);
+    printf("avg frames   %.1f per match\n", stats->matches ? (double)stats->frames / stats->matches : 0.0);
+    printf("wins         left %llu, right %llu\n",
+           (unsigned long long)stats->wins[SIM_SIDE_LEFT], (unsigned long long)stats->wins[SIM_SIDE_RIGHT]);
+    printf("points       left %llu, right %llu\n",
+           (unsigned long long)stats->pointsWon[SIM_SIDE_LEFT], (unsigned long long)stats->pointsWon[SIM_SIDE_RIGHT]);
+
+    printf("\nfinal score distribution (winner-loser: count)\n");
+    for (int winner = 0; winner < 2; winner++) {
+        for (int s = 0; s < config->winScore; s++) {
+            if (stats->loserScore[winner][s] == 0) continue;
+            printf("  %-5s %d-%-3d %llu\n", winner == SIM_SIDE_LEFT ? "left" : "right",
+                   config->winScore, s, (unsigned long long)stats->loserScore[winner][s]);
+        }
+    }
+
+    printf("\nrally length (paddle hits per point: count)\n");
+    for (int i = 0; i < RALLY_BUCKETS; i++) {
+        if (stats->rallyHistogram[i] == 0) continue;
+        printf("  %s%-4d %llu\n", (i == RALLY_BUCKETS - 1) ? ">=" : "  ", i,
+               (unsigned long long)stats->rallyHistogram[i]);
+    }
+}
+
+// Ticks per second for N matches stepped through SimStep, one match after another
+static double TimeScalarEngine(const BatchConfig *config, uint64_t *framesOut) {
+    SimState *sims = malloc((size_t)config->matches * sizeof(SimState));
+    if (sims == NULL) return 0.0;
+
+    for (int i = 0; i < config->matches; i++) {
+        SimInit(&sims[i], config->speed, config->winScore, MatchSeed(config->seed, (uint32_t)i));
+        SimSetAi(&sims[i], SIM_SIDE_LEFT, &config->ai[SIM_SIDE_LEFT]);
+        SimSetAi(&sims[i], SIM_SIDE_RIGHT, &config->ai[SIM_SIDE_RIGHT]);
+    }
+
+    SimInput input = { 0 };
+    input.aiControlled[SIM_SIDE_LEFT] = true;
+    input.aiControlled[SIM_SIDE_RIGHT] = true;
+    SimEvent events[SIM_MAX_EVENTS];
+
+    uint64_t frames = 0;
+    double start = TimerNowSeconds();
+    for (uint32_t tick = 0; tick < config->maxFrames; tick++) {
+        for (int i = 0; i < config->matches; i++) {
+            if (sims[i].matchOver) continue;
+            SimStep(&sims[i], &input, events);
+            frames++;
+        }
+    }
+    double seconds = TimerNowSeconds() - start;
+
+    free(sims);
+    *framesOut = frames;
+    return seconds;
+}
+
+static double TimeSoAEngine(const BatchConfig *config, bool simd, uint64_t *framesOut) {
+    SimSoA soa;
+    if (SimSoAInit(&soa, config->matches, config->speed, config->winScore, config->seed) != 0) return 0.0;
+
+    double start = TimerNowSeconds();
+    for (uint32_t tick = 0; tick < config->maxFrames; tick++) {
+        int running = simd ? SimSoAStep(&soa) : SimSoAStepScalar(&soa);
+        if (running == 0) break;
+    }
+    double seconds = TimerNowSeconds() - start;
+
+    uint64_t frames = 0;
+    for (int i = 0; i < soa.count; i++) frames += soa.frames[i];
+
+    SimSoAFree(&soa);
+    *framesOut = frames;
+    return seconds;
+}
+
+static void CompareEngines(const BatchConfig *config) {
+    uint64_t frames[3];
+    double seconds[3];
+    const char *names[3] = { "SimStep (AoS)", "SoA scalar", NULL };
+
+    seconds[0] = TimeScalarEngine(config, &frames[0]);
+    seconds[1] = TimeSoAEngine(config, false, &frames[1]);
+    seconds[2] = TimeSoAEngine(config, true, &frames[2]);
+
+    char simdName[32];
+    snprintf(simdName, sizeof(simdName), "SoA %s x%d", SimSoAKernelName(), SIM_SOA_LANES);
+    names[2] = simdName;
+
+    printf("%d matches, up to %u ticks, one thread\n\n", config->matches, config->maxFrames);
+    printf("%-18s %14s %16s %9s\n", "engine", "match-ticks", "ticks/sec", "speedup");
+    double baseRate = (seconds[1] > 0.0) ? frames[1] / seconds[1] : 0.0;
+    for (int e = 0; e < 3; e++) {
+        double rate = (seconds[e] > 0.0) ? frames[e] / seconds[e] : 0.0;
+        if (e == 0) {
+            // Different rules (swept contact, tiered AI), so no speedup against it
+            printf("%-18s %14llu %16.0f %9s\n", names[e], (unsigned long long)frames[e], rate, "-");
+        } else {
+            printf("%-18s %14llu %16.0f %8.2fx\n", names[e], (unsigned long long)frames[e], rate,
+                   baseRate > 0.0 ? rate / baseRate : 0.0);
+        }
+    }
+    printf("\nspeedups are against SoA scalar; SimStep plays the full rules and is shown for scale only\n");
+}
+
+static void PrintUsage(const char *program) {
+    fprintf(stderr,
+            "usage: %s [--matches N] [--threads T] [--speed M] [--win W] [--seed S] [--max-frames F]\n"
+            "          [--left AI] [--right AI] [--soa | --calibrate]\n"
+            "AI is easy, normal, hard, expert or reference\n",
+            program);
+}
+
+static bool ParseAi(const char *name, SimAiProfile *profile) {
+    if (strcmp(name, "reference") == 0) {
+        *profile = *SimAiReferenceProfile();
+        return true;
+    }
+    SimAiTier tier;
+    if (!SimAiTierFromName(name, &tier)) return false;
+    *profile = *SimAiTierProfile(tier);
+    return true;
+}
+
+// Play config->matches matches across config->threads workers
+static BatchStats RunBatch(const BatchConfig *config, double *seconds) {
+    BatchStats total = { 0 };
+    BatchWorker *workers = calloc((size_t)config->threads, sizeof(BatchWorker));
+    pthread_t *threads = calloc((size_t)config->threads, sizeof(pthread_t));
+    if (workers == NULL || threads == NULL) {
+        fprintf(stderr, "out of memory\n");
+        exit(1);
+    }
+
+    // Deal matches out in equal contiguous slices; stealing evens out the rest
+    for (int i = 0; i < config->threads; i++) {
+        uint32_t head = (uint32_t)((uint64_t)config->matches * i / config->threads);
+        uint32_t tail = (uint32_t)((uint64_t)config->matches * (i + 1) / config->threads);
+        atomic_init(&workers[i].range, PackRange(head, tail));
+        workers[i].config = config;
+        workers[i].index = i;
+        workers[i].workerCount = config->threads;
+        workers[i].all = workers;
+    }
+
+    double start = TimerNowSeconds();
+    for (int i = 0; i < config->threads; i++) {
+        pthread_create(&threads[i], NULL, WorkerMain, &workers[i]);
+    }
+    for (int i = 0; i < config->threads; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    *seconds = TimerNowSeconds() - start;
+
+    for (int i = 0; i < config->threads; i++) MergeStats(&total, &workers[i].stats);
+    free(threads);
+    free(workers);
+    return total;
+}
+
+// Share of points the right side won
+static double RightWinRate(const BatchStats *stats) {
+    return stats->points ? (double)stats->pointsWon[SIM_SIDE_RIGHT] / stats->points : 0.0;
+}
+
+// Bisect each tier's skill against the reference model. Every evaluation
+// replays the same match seeds, so the win rate moves with skill alone.
+static void Calibrate(BatchConfig config) {
+    config.ai[SIM_SIDE_LEFT] = *SimAiReferenceProfile();
+    SimAiProfile results[SIM_AI_TIER_COUNT];
+
+    printf("calibrating against the reference model, %d matches per step\n\n", config.matches);
+    printf("%-8s %7s %9s %10s\n", "tier", "target", "skill", "points won");
+    for (int tier = 0; tier < SIM_AI_TIER_COUNT; tier++) {
+        float lo = 0.0f, hi = 1.0f;
+        double rate = 0.0;
+        for (int step = 0; step < CALIBRATION_STEPS; step++) {
+            float skill = (lo + hi) * 0.5f;
+            config.ai[SIM_SIDE_RIGHT] = SimAiProfileFromSkill(skill);
+
+            double seconds;
+            BatchStats stats = RunBatch(&config, &seconds);
+            rate = RightWinRate(&stats);
+            if (rate < tierTargetWinRate[tier]) lo = skill; else hi = skill;
+        }
+
+        float skill = (lo + hi) * 0.5f;
+        results[tier] = SimAiProfileFromSkill(skill);
+        printf("%-8s %6.0f%% %9.4f %9.1f%%\n", SimAiTierName((SimAiTier)tier),
+               tierTargetWinRate[tier] * 100.0f, skill, rate * 100.0);
+    }
+
+    printf("\n// Generated by `pongbatch --calibrate`\n");
+    printf("static const SimAiProfile aiTiers[SIM_AI_TIER_COUNT] = {\n");
+    for (int tier = 0; tier < SIM_AI_TIER_COUNT; tier++) {
+        char label[32];
+        snprintf(label, sizeof(label), "[SIM_AI_%s]", SimAiTierName((SimAiTier)tier));
+        for (char *c = label; *c != '\0'; c++) {
+            if (*c >= 'a' && *c <= 'z') *c = (char)(*c - 'a' + 'A');
+        }
+        printf("    %-15s = { %d, %.1ff, %.1ff, %.2ff },\n", label, results[tier].reactionTicks,
+               results[tier].aimError, results[tier].maxSpeed, results[tier].maxAccel);
+    }
+    printf("};\n");
+}
+
+int main(int argc, char **argv) {
+    BatchConfig config = {
+        .matches = 10000,
+        .threads = CpuCount(),
+        .speed = 1.0f,
+        .winScore = SIM_DEFAULT_WIN_SCORE,
+        .seed = 1,
+        .maxFrames = DEFAULT_MAX_FRAMES,
+        .ai = { *SimAiTierProfile(SIM_AI_NORMAL), *SimAiTierProfile(SIM_AI_NORMAL) }
+    };
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--soa") == 0) {
+            config.compareSoA = true;
+            continue;
+        }
+        if (strcmp(argv[i], "--calibrate") == 0) {
+            config.calibrate = true;
+            continue;
+        }
+
+        const char *value = (i + 1 < argc) ? argv[i + 1] : NULL;
+        if (value == NULL) { PrintUsage(argv[0]); return 1; }
+
+        if (strcmp(argv[i], "--matches") == 0) config.matches = atoi(value);
+        else if (strcmp(argv[i], "--threads") == 0) config.threads = atoi(value);
+        else if (strcmp(argv[i], "--speed") == 0) config.speed = (float)atof(value);
+        else if (strcmp(argv[i], "--win") == 0) config.winScore = atoi(value);
+        else if (strcmp(argv[i], "--seed") == 0) config.seed = (uint32_t)strtoul(value, NULL, 10);
+        else if (strcmp(argv[i], "--max-frames") == 0) config.maxFrames = (uint32_t)strtoul(value, NULL, 10);
+        else if (strcmp(argv[i], "--left") == 0 && ParseAi(value, &config.ai[SIM_SIDE_LEFT])) {}
+        else if (strcmp(argv[i], "--right") == 0 && ParseAi(value, &config.ai[SIM_SIDE_RIGHT])) {}
+        else { PrintUsage(argv[0]); return 1; }
+        i++;
+    }
+
+    if (config.matches <= 0 || config.threads <= 0 || config.winScore <= 0 || config.winScore > MAX_WIN_SCORE) {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+    if (config.threads > MAX_WORKERS) config.threads = MAX_WORKERS;
+
+    if (config.compareSoA) {
+        CompareEngines(&config);
+        return 0;
+    }
+    if (config.calibrate) {
+        Calibrate(config);
+        return 0;
+    }
+
+    double seconds;
+    BatchStats total = RunBatch(&config, &seconds);
+    PrintReport(&config, &total, seconds);
+    return 0;
+}
@@ -0,0 +1,183 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2025, BISMAYA JYOTI DALEI
+
+See the LICENSE file in the project root for the full license text.
+*/
+
+// Headless netplay peer for testing rollback over loopback. Each process
+// steers its own paddle with a simple ball-chasing bot at 60 ticks per second,
+// plays a fixed number of ticks, waits until every remote input up to that
+// tick is confirmed and then prints a checksum of the final state. Two peers
+// that agree on the checksum simulated the same match.
+//
+//   pongnet --host PORT [--seed S] [--frames N] [--netsim LAT,JITTER,LOSS]
+//   pongnet --join ADDRESS:PORT [--frames N] [--netsim LAT,JITTER,LOSS]
+//
+// For example, in two terminals:
+//   pongnet --host 7777 --netsim 60,20,10
+//   pongnet --join 127.0.0.1:7777 --netsim 60,20,10
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200112L   // nanosleep
+#endif
+
+#include "../src/netplay.h"
+#include "../src/timer.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#define TICK_SECONDS (1.0 / 60.0)
+
+static Netplay net;   // Large (delayed packet queue), keep it off the stack
+
+static void SleepMs(int ms) {
+#if defined(_WIN32)
+    Sleep((DWORD)ms);
+#else
+    struct timespec duration = { ms / 1000, (long)(ms % 1000) * 1000000L };
+    nanosleep(&duration, NULL);
+#endif
+}
+
+// Drive towards the ball like a player holding a key: full up, full down or idle
+static int8_t BotAxis(const SimState *sim, SimSide side) {
+    const SimPaddle *paddle = &sim->paddles[side];
+    float offset = sim->ball.position.y - (paddle->rect.y + paddle->rect.height / 2);
+    if (offset < -paddle->rect.height / 4) return -SIM_AXIS_MAX;
+    if (offset > paddle->rect.height / 4) return SIM_AXIS_MAX;
+    return 0;
+}
+
+// FNV-1a over the fields that define the match (not raw bytes: padding differs)
+static uint64_t HashState(const SimState *sim) {
+    uint64_t hash = 0xcbf29ce484222325ull;
+    const float values[] = {
+        sim->ball.position.x, sim->ball.position.y, sim->ball.velocity.x, sim->ball.velocity.y,
+        sim->paddles[0].rect.y, sim->paddles[1].rect.y
+    };
+    const unsigned char *bytes = (const unsigned char *)values;
+    for (size_t i = 0; i < sizeof(values); i++) hash = (hash ^ bytes[i]) * 0x100000001b3ull;
+
+    const uint32_t words[] = {
+        (uint32_t)sim->scores[0], (uint32_t)sim->scores[1], sim->frame,
+        sim->rng.s[0], sim->rng.s[1], sim->rng.s[2], sim->rng.s[3]
+    };
+    bytes = (const unsigned char *)words;
+    for (size_t i = 0; i < sizeof(words); i++) hash = (hash ^ bytes[i]) * 0x100000001b3ull;
+    return hash;
+}
+
+static void PrintUsage(const char *program) {
+    fprintf(stderr,
+            "usage: %s (--host PORT | --join ADDRESS:PORT) [--seed S] [--frames N] [--netsim LAT,JITTER,LOSS]\n",
+            program);
+}
+
+int main(int argc, char **argv) {
+    int hostPort = 0;
+    char joinAddress[256] = { 0 };
+    int joinPort = 0;
+    uint64_t seed = 1;
+    uint32_t frames = 3600;
+    NetConditions conditions = { 0, 0, 0 };
+
+    for (int i = 1; i < argc; i++) {
+        const char *value = (i + 1 < argc) ? argv[i + 1] : NULL;
+        if (value == NULL) { PrintUsage(argv[0]); return 1; }
+
+        if (strcmp(argv[i], "--host") == 0) hostPort = atoi(value);
+        else if (strcmp(argv[i], "--join") == 0) {
+            const char *colon = strrchr(value, ':');
+            if (colon == NULL || colon - value >= (int)sizeof(joinAddress)) { PrintUsage(argv[0]); return 1; }
+            memcpy(joinAddress, value, (size_t)(colon - value));
+            joinPort = atoi(colon + 1);
+        }
+        else if (strcmp(argv[i], "--seed") == 0) seed = strtoull(value, NULL, 10);
+        else if (strcmp(argv[i], "--frames") == 0) frames = (uint32_t)strtoul(value, NULL, 10);
+        else if (strcmp(argv[i], "--netsim") == 0) {
+            if (!NetplayParseConditions(value, &conditions)) { PrintUsage(argv[0]); return 1; }
+        }
+        else { PrintUsage(argv[0]); return 1; }
+        i++;
+    }
+
+    if ((hostPort > 0) == (joinPort > 0) || frames == 0) {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+
+    bool opened = (hostPort > 0)
+        ? NetplayHost(&net, hostPort, seed, 1.0f, SIM_DEFAULT_WIN_SCORE, &conditions)
+        : NetplayJoin(&net, joinAddress, joinPort, &conditions);
+    if (!opened) {
+        fprintf(stderr, "could not open the network socket\n");
+        return 1;
+    }
+
+    printf("%s, waiting for peer...\n", net.isHost ? "hosting" : "joining");
+    fflush(stdout);
+    while (net.status == NET_STATUS_CONNECTING) {
+        NetplayPoll(&net);
+        SleepMs(1);
+    }
+    if (net.status != NET_STATUS_RUNNING) {
+        fprintf(stderr, "connection failed\n");
+        return 1;
+    }
+
+    SimState sim;
+    SimInit(&sim, net.ballSpeedMultiplier, net.winScore, net.seed);
+
+    // Fixed 60 Hz ticks until we've played our share
+    double start = TimerNowSeconds();
+    double nextTick = start;
+    while (net.currentFrame < frames && net.status == NET_STATUS_RUNNING) {
+        NetplayPoll(&net);
+        if (TimerNowSeconds() < nextTick) {
+            SleepMs(1);
+            continue;
+        }
+
+        SimEvent events[SIM_MAX_EVENTS];
+        int eventCount;
+        if (NetplayAdvance(&net, &sim, BotAxis(&sim, net.localSide), events, &eventCount)) {
+            nextTick += TICK_SECONDS;
+        } else {
+            SleepMs(1);   // Stalled waiting for the peer
+        }
+    }
+
+    // Keep the link alive until the peer's inputs for every tick are in
+    while (net.remoteConfirmed < frames && net.status == NET_STATUS_RUNNING) {
+        NetplayPoll(&net);
+        SleepMs(1);
+    }
+    NetplayResolve(&net, &sim);
+
+    // Give the peer a moment to collect our last inputs before closing
+    double lingerUntil = TimerNowSeconds() + 1.0;
+    while (TimerNowSeconds() < lingerUntil) {
+        NetplayPoll(&net);
+        SleepMs(1);
+    }
+
+    bool complete = net.remoteConfirmed >= frames;
+    printf("side %s  frames %u  score %d-%d  rollbacks %u  resimulated %u  stalls %u\n",
+           net.localSide == SIM_SIDE_LEFT ? "left" : "right", net.currentFrame,
+           sim.scores[SIM_SIDE_LEFT], sim.scores[SIM_SIDE_RIGHT],
+           net.rollbacks, net.resimulatedFrames, net.stalls);
+    printf("state %016llx%s\n", (unsigned long long)HashState(&sim), complete ? "" : "  (incomplete)");
+
+    NetplayClose(&net);
+    return complete ? 0 : 1;
+}